@@ -0,0 +1,85 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#define BENCH_RUSAGE
+#endif
+
+/*
+ * Helpers shared by the benchmarks.
+ * Results are printed one per line as JSON objects (or CSV if bench_csv_output is set).
+ */
+
+/* ----------------------------| Measuring |-------------------------------------------------------- */
+/* time relative to the first call, so the nanoseconds do not exceed the precision of a double */
+static double bench_now_ns()
+{
+    static time_t base = 0;
+
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    if (!base) base = ts.tv_sec;
+
+    return (double)(ts.tv_sec - base) * 1e9 + ts.tv_nsec;
+}
+
+static int bench_cmp_double(const void* left, const void* right)
+{
+    double l = *(const double*)left;
+    double r = *(const double*)right;
+    return (l > r) - (l < r);
+}
+
+typedef void (*bench_func)(void* arg);
+
+/* returns the median time of a call in ns, every round runs enough calls to take about 1 ms */
+static double bench_measure(bench_func func, void* arg, int rounds)
+{
+    double start = bench_now_ns();
+    size_t calls = 0;
+    while (bench_now_ns() - start < 1e6 || calls == 0)
+    {
+        func(arg);
+        calls++;
+    }
+
+    double* samples = malloc(rounds * sizeof(double));
+    if (!samples) return 0.0;
+
+    for (int r = 0; r < rounds; ++r)
+    {
+        start = bench_now_ns();
+        for (size_t i = 0; i < calls; ++i) func(arg);
+        samples[r] = (bench_now_ns() - start) / calls;
+    }
+
+    qsort(samples, rounds, sizeof(double), bench_cmp_double);
+    double median = samples[rounds / 2];
+    free(samples);
+
+    return median;
+}
+
+static int bench_csv_output = 0;
+
+static void bench_report(const char* name, double value, const char* unit)
+{
+    if (bench_csv_output)   printf("%s,%.3f,%s\n", name, value, unit);
+    else                    printf("{\"name\": \"%s\", \"value\": %.3f, \"unit\": \"%s\"}\n", name, value, unit);
+}
+
+static void bench_report_rss()
+{
+#ifdef BENCH_RUSAGE
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) bench_report("max_rss", (double)usage.ru_maxrss, "kb");
+#endif
+}
+
+#endif /* !BENCH_H */
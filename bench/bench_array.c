@@ -0,0 +1,571 @@
+#include "../src/tb_array.h"
+#include "../src/tb_segarray.h"
+#include "../src/tb_soa.h"
+#include "../src/tb_ring.h"
+#include "../src/tb_file.h"
+
+#include "bench.h"
+
+/*
+ * Benchmarks for the bulk operations of tb_array against loops of single element operations,
+ * for many tiny arrays against small arrays with inline storage, for tb_segarray against
+ * tb_array, for a loop over two fields of records against tb_soa columns, for queues in a
+ * tb_array against tb_ring, for the growth of large arrays with realloc and with
+ * tb_array_mmap_allocator and for checkpoints written with fwrite and read with tb_file_read
+ * against file arrays.
+ *
+ * usage: bench_array [options]
+ *   -n <n>      number of elements, also the number of tiny arrays (default 100000)
+ *   -k <n>      number of elements inserted or erased in the middle, also the queue length (default 1000)
+ *   -m <n>      size in MiB the large arrays grow to (default 256)
+ *   -c <n>      size in MiB of the checkpoint (default 64)
+ *   -r <n>      rounds per benchmark (default 15)
+ *   -f <fmt>    output format: json or csv (default json)
+ */
+
+typedef struct
+{
+    int count;
+    int range;
+    int large;
+    int checkpoint;
+    int rounds;
+    int csv_output;
+} bench_config;
+
+typedef struct
+{
+    const int* src;
+    size_t count;
+    size_t range;
+    volatile size_t sink;
+} bench_state;
+
+/* ----------------------------| Append |----------------------------------------------------------- */
+static void bench_push_loop(void* arg)
+{
+    bench_state* state = arg;
+    int* array = NULL;
+
+    for (size_t i = 0; i < state->count; ++i) tb_array_push(array, state->src[i]);
+
+    state->sink += tb_array_len(array);
+    tb_array_free(array);
+}
+
+static void bench_append_n(void* arg)
+{
+    bench_state* state = arg;
+    int* array = NULL;
+
+    tb_array_append_n(array, state->src, state->count);
+
+    state->sink += tb_array_len(array);
+    tb_array_free(array);
+}
+
+static void bench_add_uninit(void* arg)
+{
+    bench_state* state = arg;
+    int* array = NULL;
+
+    int* dst = tb_array_add_uninit(array, state->count);
+    for (size_t i = 0; i < state->count; ++i) dst[i] = (int)i;
+
+    state->sink += tb_array_len(array);
+    tb_array_free(array);
+}
+
+/* ----------------------------| Insert and erase |------------------------------------------------- */
+static void bench_insert_loop(void* arg)
+{
+    bench_state* state = arg;
+    int* array = NULL;
+    tb_array_append_n(array, state->src, state->count);
+
+    /* one grow and memmove per element */
+    size_t middle = state->count / 2;
+    for (size_t i = 0; i < state->range; ++i)
+    {
+        tb_array_grow(array, 1);
+        memmove(array + middle + i + 1, array + middle + i, (tb_array__len(array) - middle - i) * sizeof(int));
+        array[middle + i] = state->src[i];
+        tb_array__len(array)++;
+    }
+
+    state->sink += tb_array_len(array);
+    tb_array_free(array);
+}
+
+static void bench_insert_n(void* arg)
+{
+    bench_state* state = arg;
+    int* array = NULL;
+    tb_array_append_n(array, state->src, state->count);
+
+    tb_array_insert_n(array, state->count / 2, state->src, state->range);
+
+    state->sink += tb_array_len(array);
+    tb_array_free(array);
+}
+
+static void bench_erase_loop(void* arg)
+{
+    bench_state* state = arg;
+    int* array = NULL;
+    tb_array_append_n(array, state->src, state->count);
+
+    size_t middle = state->count / 2;
+    for (size_t i = 0; i < state->range; ++i)
+    {
+        memmove(array + middle, array + middle + 1, (tb_array__len(array) - middle - 1) * sizeof(int));
+        tb_array__len(array)--;
+    }
+
+    state->sink += tb_array_len(array);
+    tb_array_free(array);
+}
+
+static void bench_erase_n(void* arg)
+{
+    bench_state* state = arg;
+    int* array = NULL;
+    tb_array_append_n(array, state->src, state->count);
+
+    tb_array_erase_n(array, state->count / 2, state->range);
+
+    state->sink += tb_array_len(array);
+    tb_array_free(array);
+}
+
+static void bench_swap_remove(void* arg)
+{
+    bench_state* state = arg;
+    int* array = NULL;
+    tb_array_append_n(array, state->src, state->count);
+
+    size_t middle = state->count / 2;
+    for (size_t i = 0; i < state->range; ++i) tb_array_swap_remove(array, middle);
+
+    state->sink += tb_array_len(array);
+    tb_array_free(array);
+}
+
+/* ----------------------------| Tiny arrays |------------------------------------------------------ */
+#define BENCH_TINY_LEN      6
+#define BENCH_TINY_INLINE   8
+
+typedef tb_array_small(int, BENCH_TINY_INLINE) bench_small;
+
+/* one array per object, most of them hold only a few elements */
+static void bench_tiny_arrays(void* arg)
+{
+    bench_state* state = arg;
+    int** arrays = calloc(state->count, sizeof(int*));
+    if (!arrays) return;
+
+    for (size_t i = 0; i < state->count; ++i)
+        for (int k = 0; k < BENCH_TINY_LEN; ++k) tb_array_push(arrays[i], k);
+
+    for (size_t i = 0; i < state->count; ++i)
+    {
+        state->sink += arrays[i][BENCH_TINY_LEN - 1];
+        tb_array_free(arrays[i]);
+    }
+
+    free(arrays);
+}
+
+static void bench_small_arrays(void* arg)
+{
+    bench_state* state = arg;
+    bench_small* arrays = calloc(state->count, sizeof(bench_small));
+    if (!arrays) return;
+
+    for (size_t i = 0; i < state->count; ++i)
+        for (int k = 0; k < BENCH_TINY_LEN; ++k) tb_array_small_push(arrays[i], k);
+
+    for (size_t i = 0; i < state->count; ++i)
+    {
+        state->sink += tb_array_small_data(arrays[i])[BENCH_TINY_LEN - 1];
+        tb_array_small_free(arrays[i]);
+    }
+
+    free(arrays);
+}
+
+/* ----------------------------| Segmented arrays |------------------------------------------------- */
+static void bench_segarray_push(void* arg)
+{
+    bench_state* state = arg;
+    tb_segarray array;
+    tb_segarray_init(&array, sizeof(int), 0, NULL);
+
+    for (size_t i = 0; i < state->count; ++i) tb_segarray_push(&array, &state->src[i]);
+
+    state->sink += tb_segarray_len(&array);
+    tb_segarray_destroy(&array);
+}
+
+/* sums through the chunk table, compared to the same loop over a tb_array */
+static void bench_segarray_access(void* arg)
+{
+    bench_state* state = arg;
+    tb_segarray array;
+    tb_segarray_init(&array, sizeof(int), 0, NULL);
+    tb_segarray_resize(&array, state->count);
+
+    for (size_t i = 0; i < state->count; ++i) *(int*)tb_segarray_at(&array, i) = state->src[i];
+
+    size_t sum = 0;
+    for (size_t i = 0; i < state->count; ++i) sum += *(int*)tb_segarray_at(&array, i);
+
+    state->sink += sum;
+    tb_segarray_destroy(&array);
+}
+
+static void bench_array_access(void* arg)
+{
+    bench_state* state = arg;
+    int* array = NULL;
+    tb_array_resize(array, state->count);
+    tb_array__len(array) = state->count;
+
+    for (size_t i = 0; i < state->count; ++i) array[i] = state->src[i];
+
+    size_t sum = 0;
+    for (size_t i = 0; i < state->count; ++i) sum += array[i];
+
+    state->sink += sum;
+    tb_array_free(array);
+}
+
+/* ----------------------------| Struct of arrays |------------------------------------------------- */
+typedef struct
+{
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    int id;
+} bench_record;
+
+#define BENCH_RECORD_FIELDS(X) X(float, x) X(float, y) X(float, z) X(float, vx) X(float, vy) X(float, vz) X(float, mass) X(int, id)
+
+TB_SOA_DECLARE(bench_particles, BENCH_RECORD_FIELDS)
+
+typedef struct
+{
+    bench_record* records;
+    bench_particles soa;
+    size_t count;
+    volatile float sink;
+} bench_soa_state;
+
+/* the update reads and writes two of the eight fields */
+static void bench_aos_update(void* arg)
+{
+    bench_soa_state* state = arg;
+    bench_record* records = state->records;
+
+    for (size_t i = 0; i < state->count; ++i) records[i].x += records[i].vx * 0.01f;
+
+    state->sink = records[state->count / 2].x;
+}
+
+static void bench_soa_update(void* arg)
+{
+    bench_soa_state* state = arg;
+    float* restrict x = state->soa.x;
+    const float* restrict vx = state->soa.vx;
+
+    for (size_t i = 0; i < state->count; ++i) x[i] += vx[i] * 0.01f;
+
+    state->sink = x[state->count / 2];
+}
+
+static void bench_soa_push(void* arg)
+{
+    bench_soa_state* state = arg;
+    bench_particles soa = { 0 };
+
+    for (size_t i = 0; i < state->count; ++i)
+        bench_particles_push(&soa, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, (int)i);
+
+    state->sink = (float)soa.len;
+    bench_particles_free(&soa);
+}
+
+/* ----------------------------| Queues |----------------------------------------------------------- */
+/* count enqueues and dequeues on a queue that holds range elements */
+static void bench_queue_array(void* arg)
+{
+    bench_state* state = arg;
+    int* queue = NULL;
+    tb_array_append_n(queue, state->src, state->range);
+
+    for (size_t i = 0; i < state->count; ++i)
+    {
+        state->sink += queue[0];
+        tb_array_erase_n(queue, 0, 1);
+        tb_array_push(queue, state->src[i]);
+    }
+
+    tb_array_free(queue);
+}
+
+static void bench_queue_ring(void* arg)
+{
+    bench_state* state = arg;
+    int* queue = NULL;
+    tb_ring_push_back_n(queue, state->src, state->range);
+
+    for (size_t i = 0; i < state->count; ++i)
+    {
+        state->sink += tb_ring_pop_front(queue);
+        tb_ring_push_back(queue, state->src[i]);
+    }
+
+    tb_ring_free(queue);
+}
+
+/* ----------------------------| Large arrays |----------------------------------------------------- */
+/* grows an array in 1 MiB appends, returns the total time and writes the slowest append to worst */
+static double bench_large_growth(tb_allocator* allocator, size_t mib, double* worst)
+{
+    size_t chunk_size = 1 << 20;
+    char* chunk = malloc(chunk_size);
+    if (!chunk) return 0.0;
+
+    memset(chunk, 1, chunk_size);
+
+    char* array = NULL;
+    if (allocator) tb_array_create(array, 0, allocator);
+
+    *worst = 0.0;
+    double start = bench_now_ns();
+    for (size_t i = 0; i < mib; ++i)
+    {
+        double append = bench_now_ns();
+        tb_array_append_n(array, chunk, chunk_size);
+        append = bench_now_ns() - append;
+
+        if (append > *worst) *worst = append;
+    }
+    double total = bench_now_ns() - start;
+
+    tb_array_free(array);
+    free(chunk);
+
+    return total;
+}
+
+/* ----------------------------| Checkpoints |------------------------------------------------------ */
+#define BENCH_CHECKPOINT_PATH   "bench_array.checkpoint"
+
+static size_t bench_sum(const size_t* values, size_t count)
+{
+    size_t sum = 0;
+    for (size_t i = 0; i < count; ++i) sum += values[i];
+    return sum;
+}
+
+/* saves and loads mib MiB with fwrite and tb_file_read and with a file array */
+static void bench_checkpoint(size_t mib)
+{
+    size_t count = (mib << 20) / sizeof(size_t);
+    size_t* values = NULL;
+    tb_array_resize(values, count);
+    if (!values) return;
+
+    for (size_t i = 0; i < count; ++i) values[i] = i;
+    tb_array__len(values) = count;
+
+    double start = bench_now_ns();
+    FILE* stream = fopen(BENCH_CHECKPOINT_PATH, "wb");
+    if (stream)
+    {
+        fwrite(values, sizeof(size_t), count, stream);
+        fclose(stream);
+    }
+    bench_report("checkpoint_fwrite", (bench_now_ns() - start) / 1e6, "ms");
+
+    /* loading copies the file into a buffer */
+    start = bench_now_ns();
+    size_t* loaded = (size_t*)tb_file_read(BENCH_CHECKPOINT_PATH, "rb");
+    bench_report("checkpoint_file_read", (bench_now_ns() - start) / 1e6, "ms");
+
+    start = bench_now_ns();
+    size_t sum = loaded ? bench_sum(loaded, count) : 0;
+    bench_report("checkpoint_file_read_scan", (bench_now_ns() - start) / 1e6, "ms");
+    free(loaded);
+    remove(BENCH_CHECKPOINT_PATH);
+
+    size_t* mapped = NULL;
+    if (!tb_array_file_open(mapped, BENCH_CHECKPOINT_PATH))
+    {
+        tb_array_free(values);
+        return;
+    }
+
+    start = bench_now_ns();
+    tb_array_append_n(mapped, values, count);
+    tb_array_file_flush(mapped);
+    bench_report("checkpoint_file_array_save", (bench_now_ns() - start) / 1e6, "ms");
+
+    tb_array_file_close(mapped);
+
+    /* reopening only maps the file, the pages are read on the first access */
+    start = bench_now_ns();
+    tb_array_file_open(mapped, BENCH_CHECKPOINT_PATH);
+    bench_report("checkpoint_file_array_open", (bench_now_ns() - start) / 1e6, "ms");
+
+    start = bench_now_ns();
+    size_t mapped_sum = mapped ? bench_sum(mapped, tb_array_len(mapped)) : 0;
+    bench_report("checkpoint_file_array_scan", (bench_now_ns() - start) / 1e6, "ms");
+
+    if (mapped_sum != sum) fprintf(stderr, "checkpoint mismatch\n");
+
+    tb_array_file_close(mapped);
+    remove(BENCH_CHECKPOINT_PATH);
+    tb_array_free(values);
+}
+
+/* only the copy into the array that the other insert and erase benchmarks also do */
+static void bench_baseline(void* arg)
+{
+    bench_state* state = arg;
+    int* array = NULL;
+    tb_array_append_n(array, state->src, state->count);
+
+    state->sink += tb_array_len(array);
+    tb_array_free(array);
+}
+
+static int bench_parse_args(bench_config* config, int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 >= argc) return 1;
+
+        const char* value = argv[++i];
+        switch (argv[i - 1][1])
+        {
+        case 'n': config->count = atoi(value); break;
+        case 'k': config->range = atoi(value); break;
+        case 'm': config->large = atoi(value); break;
+        case 'c': config->checkpoint = atoi(value); break;
+        case 'r': config->rounds = atoi(value); break;
+        case 'f': config->csv_output = strcmp(value, "csv") == 0; break;
+        default: return 1;
+        }
+    }
+
+    return config->count < 2 || config->range < 1 || config->range > config->count / 2 || config->large < 1 || config->checkpoint < 1 || config->rounds < 1;
+}
+
+int main(int argc, char** argv)
+{
+    bench_config config = { 100000, 1000, 256, 64, 15, 0 };
+    if (bench_parse_args(&config, argc, argv) != 0)
+    {
+        fprintf(stderr, "usage: %s [-n count] [-k range (at most count / 2)] [-m MiB] [-c MiB] [-r rounds] [-f json|csv]\n", argv[0]);
+        return 1;
+    }
+
+    int* src = malloc(config.count * sizeof(int));
+    if (!src) return 1;
+
+    for (int i = 0; i < config.count; ++i) src[i] = i;
+
+    bench_state state = { src, (size_t)config.count, (size_t)config.range, 0 };
+
+    bench_csv_output = config.csv_output;
+    if (bench_csv_output) printf("name,value,unit\n");
+
+    bench_report("count", config.count, "count");
+    bench_report("range", config.range, "count");
+
+    double push = bench_measure(bench_push_loop, &state, config.rounds);
+    double append = bench_measure(bench_append_n, &state, config.rounds);
+    double uninit = bench_measure(bench_add_uninit, &state, config.rounds);
+
+    bench_report("push_loop", push / 1e3, "us");
+    bench_report("append_n", append / 1e3, "us");
+    bench_report("add_uninit", uninit / 1e3, "us");
+    bench_report("append_n_speedup", push / append, "x");
+
+    /* the setup (filling the array) is measured separately and subtracted */
+    double baseline = bench_measure(bench_baseline, &state, config.rounds);
+    double insert_loop = bench_measure(bench_insert_loop, &state, config.rounds) - baseline;
+    double insert = bench_measure(bench_insert_n, &state, config.rounds) - baseline;
+    double erase_loop = bench_measure(bench_erase_loop, &state, config.rounds) - baseline;
+    double erase = bench_measure(bench_erase_n, &state, config.rounds) - baseline;
+    double swap = bench_measure(bench_swap_remove, &state, config.rounds) - baseline;
+
+    bench_report("insert_loop", insert_loop / 1e3, "us");
+    bench_report("insert_n", insert / 1e3, "us");
+    bench_report("erase_loop", erase_loop / 1e3, "us");
+    bench_report("erase_n", erase / 1e3, "us");
+    bench_report("swap_remove", swap / 1e3, "us");
+
+    double tiny = bench_measure(bench_tiny_arrays, &state, config.rounds);
+    double small = bench_measure(bench_small_arrays, &state, config.rounds);
+
+    bench_report("tiny_arrays", tiny / 1e3, "us");
+    bench_report("small_arrays", small / 1e3, "us");
+    bench_report("small_arrays_speedup", tiny / small, "x");
+
+    double seg_push = bench_measure(bench_segarray_push, &state, config.rounds);
+    double seg_access = bench_measure(bench_segarray_access, &state, config.rounds);
+    double array_access = bench_measure(bench_array_access, &state, config.rounds);
+
+    bench_report("segarray_push", seg_push / 1e3, "us");
+    bench_report("segarray_access", seg_access / 1e3, "us");
+    bench_report("array_access", array_access / 1e3, "us");
+
+    bench_soa_state soa_state = { NULL, { 0 }, (size_t)config.count, 0.0f };
+    tb_array_resize(soa_state.records, config.count);
+
+    for (int i = 0; i < config.count; ++i)
+    {
+        bench_record record = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, i };
+        soa_state.records[i] = record;
+        bench_particles_push(&soa_state.soa, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, i);
+    }
+
+    double aos_update = bench_measure(bench_aos_update, &soa_state, config.rounds);
+    double soa_update = bench_measure(bench_soa_update, &soa_state, config.rounds);
+
+    bench_report("aos_update", aos_update / 1e3, "us");
+    bench_report("soa_update", soa_update / 1e3, "us");
+    bench_report("soa_update_speedup", aos_update / soa_update, "x");
+    bench_report("soa_push", bench_measure(bench_soa_push, &soa_state, config.rounds) / 1e3, "us");
+
+    tb_array_free(soa_state.records);
+    bench_particles_free(&soa_state.soa);
+
+    double queue_array = bench_measure(bench_queue_array, &state, config.rounds);
+    double queue_ring = bench_measure(bench_queue_ring, &state, config.rounds);
+
+    bench_report("queue_array", queue_array / 1e3, "us");
+    bench_report("queue_ring", queue_ring / 1e3, "us");
+    bench_report("queue_ring_speedup", queue_array / queue_ring, "x");
+
+    /* large arrays grown with realloc and with memory mappings */
+    double worst;
+    bench_report("large_realloc", bench_large_growth(NULL, config.large, &worst) / 1e6, "ms");
+    bench_report("large_realloc_worst_append", worst / 1e6, "ms");
+
+    if (tb_array_mmap_allocator())
+    {
+        bench_report("large_mmap", bench_large_growth(tb_array_mmap_allocator(), config.large, &worst) / 1e6, "ms");
+        bench_report("large_mmap_worst_append", worst / 1e6, "ms");
+    }
+
+    bench_checkpoint(config.checkpoint);
+
+    bench_report_rss();
+
+    free(src);
+    return 0;
+}
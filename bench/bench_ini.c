@@ -0,0 +1,335 @@
+#include "../src/tb_ini.h"
+#include "../src/tb_ini_index.h"
+#include "../src/tb_ini_snapshot.h"
+
+#include "bench.h"
+
+/*
+ * Benchmarks for tb_ini with a synthetic data generator.
+ * Results are printed one per line as JSON objects (or CSV with -f csv) so they can be
+ * collected and compared across releases. Latencies are the median of several rounds.
+ *
+ * usage: bench_ini [options]
+ *   -s <n>      number of sections (default 10000)
+ *   -p <n>      properties per section (default 10)
+ *   -t <types>  value types to cycle through: i(nt) f(loat) s(tring) b(ool) c(sv) (default ifsb)
+ *   -c <n>      number of values in the CSV decoding benchmark (default 100000)
+ *   -r <n>      rounds per benchmark (default 15)
+ *   -S <n>      random seed (default 1)
+ *   -f <fmt>    output format: json or csv (default json)
+ *   -o <file>   only write the generated ini to file
+ */
+
+typedef struct
+{
+    int sections;
+    int props;
+    const char* types;
+    int csv_values;
+    int rounds;
+    unsigned seed;
+    int csv_output;
+    const char* out;
+} bench_config;
+
+/* ----------------------------| Generator |-------------------------------------------------------- */
+static unsigned bench_rand(unsigned* state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 16) & 0x7fff;
+}
+
+static size_t bench_write_value(char* dst, char type, unsigned* state)
+{
+    switch (type)
+    {
+    case 'i': return sprintf(dst, "%d", (int)bench_rand(state) * 31 - 500000);
+    case 'f': return sprintf(dst, "%.4f", bench_rand(state) / 97.0);
+    case 'b': return sprintf(dst, "%s", (bench_rand(state) & 1) ? "true" : "false");
+    case 'c': return sprintf(dst, "{%u, %u, %u, %u}", bench_rand(state), bench_rand(state), bench_rand(state), bench_rand(state));
+    default:  return sprintf(dst, "value_%u", bench_rand(state));
+    }
+}
+
+/* sections are named bench.s<i> so they form a group, properties are named key<i> */
+static char* bench_generate(const bench_config* config, size_t* len)
+{
+    size_t types = strlen(config->types);
+    size_t cap = 1024;
+    for (size_t i = 0; i < types; ++i)
+        cap += (size_t)config->sections * config->props * ((config->types[i] == 'c') ? 48 : 32) / types + 64;
+    cap += (size_t)config->sections * 32;
+
+    char* ini = malloc(cap);
+    if (!ini) return NULL;
+
+    unsigned state = config->seed;
+    size_t pos = sprintf(ini, "; generated by bench_ini\nname = bench\n\n");
+    for (int s = 0; s < config->sections; ++s)
+    {
+        pos += sprintf(ini + pos, "[bench.s%d]\n", s);
+        for (int p = 0; p < config->props; ++p)
+        {
+            pos += sprintf(ini + pos, "key%d = ", p);
+            pos += bench_write_value(ini + pos, config->types[(s + p) % types], &state);
+            ini[pos++] = '\n';
+        }
+        ini[pos++] = '\n';
+    }
+
+    ini[pos] = '\0';
+    *len = pos;
+    return ini;
+}
+
+static char* bench_generate_csv(int values, unsigned seed, size_t* len)
+{
+    char* ini = malloc((size_t)values * 12 + 64);
+    if (!ini) return NULL;
+
+    size_t pos = sprintf(ini, "[tables]\nlut = {");
+    for (int i = 0; i < values; ++i)
+        pos += sprintf(ini + pos, "%s%d", i ? ", " : "", (int)bench_rand(&seed) - 16384);
+
+    pos += sprintf(ini + pos, "}\n");
+    *len = pos;
+    return ini;
+}
+
+/* ----------------------------| Benchmarks |------------------------------------------------------- */
+typedef struct
+{
+    char* ini;
+    size_t len;
+    const char* section;
+    const char* prop;
+    const char* group;
+
+    const tb_ini_index* index;
+    const tb_ini_snapshot* snapshot;
+
+    int* values;
+    int value_count;
+
+    volatile size_t sink;
+} bench_state;
+
+static void bench_query(void* arg)
+{
+    bench_state* state = arg;
+    tb_ini_element element;
+    tb_ini_query(state->ini, state->section, state->prop, &element);
+    state->sink += element.len;
+}
+
+static void bench_index_query(void* arg)
+{
+    bench_state* state = arg;
+    tb_ini_element element;
+    tb_ini_index_query(state->index, state->section, state->prop, &element);
+    state->sink += element.len;
+}
+
+static void bench_snapshot_query(void* arg)
+{
+    bench_state* state = arg;
+    tb_ini_element element;
+    tb_ini_snapshot_query(state->snapshot, state->section, state->prop, &element);
+    state->sink += element.len;
+}
+
+static void bench_group_next(void* arg)
+{
+    bench_state* state = arg;
+    tb_ini_element section;
+
+    char* cursor = state->ini;
+    while ((cursor = tb_ini_group_next(cursor, state->group, &section)) && section.error == TB_INI_OK) state->sink++;
+}
+
+static void bench_group_cursor(void* arg)
+{
+    bench_state* state = arg;
+    tb_ini_element section;
+
+    tb_ini_cursor cursor;
+    tb_ini_cursor_init_n(&cursor, state->ini, state->len, state->group);
+    while (tb_ini_cursor_next(&cursor, &section)) state->sink++;
+}
+
+static void bench_walk(void* arg)
+{
+    bench_state* state = arg;
+    tb_ini_handler handler = { NULL, NULL, NULL };
+    state->sink += tb_ini_walk_n(state->ini, state->len, &handler);
+}
+
+static void bench_csv_step(void* arg)
+{
+    bench_state* state = arg;
+    tb_ini_element list, value;
+
+    tb_ini_csv_n(state->ini, state->len, "tables", "lut", &list);
+    const char* cursor = list.start;
+    for (size_t i = 0; i < list.len && i < (size_t)state->value_count; ++i)
+    {
+        cursor = tb_ini_csv_step_n(cursor, state->ini + state->len - cursor, &value);
+        state->values[i] = tb_ini_element_to_int(&value);
+    }
+}
+
+static void bench_csv_bulk(void* arg)
+{
+    bench_state* state = arg;
+    tb_ini_element element;
+    state->sink += tb_ini_csv_to_int_array_n(state->ini, state->len, "tables", "lut", state->values, state->value_count, &element);
+}
+
+static void bench_queries(bench_func func, const char* prefix, bench_state* state, const bench_config* config)
+{
+    char first[32], middle[32], last[32], name[64];
+    sprintf(first, "bench.s0");
+    sprintf(middle, "bench.s%d", config->sections / 2);
+    sprintf(last, "bench.s%d", config->sections - 1);
+
+    const char* last_prop = "key0";
+    char last_prop_buf[32];
+    if (config->props > 0)
+    {
+        sprintf(last_prop_buf, "key%d", config->props - 1);
+        last_prop = last_prop_buf;
+    }
+
+    struct { const char* name; const char* section; const char* prop; } cases[] =
+    {
+        { "first",              first,          "key0" },
+        { "middle",             middle,         "key0" },
+        { "last",               last,           last_prop },
+        { "missing_prop",       last,           "missing" },
+        { "missing_section",    "missing",      "key0" }
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+    {
+        state->section = cases[i].section;
+        state->prop = cases[i].prop;
+
+        sprintf(name, "%s_%s", prefix, cases[i].name);
+        bench_report(name, bench_measure(func, state, config->rounds), "ns");
+    }
+}
+
+static int bench_parse_args(bench_config* config, int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 >= argc) return 1;
+
+        const char* value = argv[++i];
+        switch (argv[i - 1][1])
+        {
+        case 's': config->sections = atoi(value); break;
+        case 'p': config->props = atoi(value); break;
+        case 't': config->types = value; break;
+        case 'c': config->csv_values = atoi(value); break;
+        case 'r': config->rounds = atoi(value); break;
+        case 'S': config->seed = (unsigned)atoi(value); break;
+        case 'f': config->csv_output = strcmp(value, "csv") == 0; break;
+        case 'o': config->out = value; break;
+        default: return 1;
+        }
+    }
+
+    return config->sections < 1 || config->props < 0 || config->rounds < 1 || config->csv_values < 1 || config->types[0] == '\0';
+}
+
+int main(int argc, char** argv)
+{
+    bench_config config = { 10000, 10, "ifsb", 100000, 15, 1, 0, NULL };
+    if (bench_parse_args(&config, argc, argv) != 0)
+    {
+        fprintf(stderr, "usage: %s [-s sections] [-p props] [-t types] [-c csv values] [-r rounds] [-S seed] [-f json|csv] [-o file]\n", argv[0]);
+        return 1;
+    }
+
+    bench_state state = { 0 };
+    state.ini = bench_generate(&config, &state.len);
+    if (!state.ini) return 1;
+
+    if (config.out)
+    {
+        FILE* file = fopen(config.out, "wb");
+        size_t written = file ? fwrite(state.ini, 1, state.len, file) : 0;
+        if (file) fclose(file);
+
+        free(state.ini);
+        return written != state.len;
+    }
+
+    bench_csv_output = config.csv_output;
+    if (bench_csv_output) printf("name,value,unit\n");
+
+    bench_report("ini_bytes", (double)state.len, "bytes");
+    bench_report("sections", config.sections, "count");
+    bench_report("props_per_section", config.props, "count");
+
+    /* in-place queries on the text */
+    bench_queries(bench_query, "query", &state, &config);
+
+    state.group = "bench";
+    bench_report("group_next", bench_measure(bench_group_next, &state, config.rounds) / 1e3, "us");
+    bench_report("group_cursor", bench_measure(bench_group_cursor, &state, config.rounds) / 1e3, "us");
+    bench_report("walk", bench_measure(bench_walk, &state, config.rounds) / 1e3, "us");
+
+    /* index */
+    tb_ini_index index;
+    double start = bench_now_ns();
+    if (tb_ini_index_build(&index, state.ini, state.len, 1, NULL, NULL) == TB_INI_OK)
+    {
+        bench_report("index_build", (bench_now_ns() - start) / 1e6, "ms");
+        bench_report("index_bytes", (double)(index.section_count * sizeof(tb_ini_index_section) + index.prop_count * sizeof(tb_ini_index_prop)), "bytes");
+
+        state.index = &index;
+        bench_queries(bench_index_query, "index_query", &state, &config);
+        tb_ini_index_destroy(&index);
+    }
+
+    /* snapshot */
+    size_t size;
+    start = bench_now_ns();
+    void* data = tb_ini_snapshot_compile(state.ini, state.len, 0, &size, NULL);
+
+    tb_ini_snapshot snapshot;
+    if (data && tb_ini_snapshot_open(&snapshot, data, size) == TB_INI_OK)
+    {
+        bench_report("snapshot_compile", (bench_now_ns() - start) / 1e6, "ms");
+        bench_report("snapshot_bytes", (double)size, "bytes");
+
+        state.snapshot = &snapshot;
+        bench_queries(bench_snapshot_query, "snapshot_query", &state, &config);
+    }
+    free(data);
+
+    /* CSV decoding on a separate buffer with a single large list */
+    free(state.ini);
+    state.ini = bench_generate_csv(config.csv_values, config.seed, &state.len);
+    state.values = malloc(config.csv_values * sizeof(int));
+    state.value_count = config.csv_values;
+
+    if (state.ini && state.values)
+    {
+        double step = bench_measure(bench_csv_step, &state, config.rounds);
+        double bulk = bench_measure(bench_csv_bulk, &state, config.rounds);
+
+        bench_report("csv_step", step / 1e3, "us");
+        bench_report("csv_bulk", bulk / 1e3, "us");
+        bench_report("csv_bulk_per_value", bulk / config.csv_values, "ns");
+    }
+
+    free(state.values);
+    free(state.ini);
+
+    bench_report_rss();
+
+    return 0;
+}
@@ -0,0 +1,211 @@
+#include "../src/tb_mem.h"
+#include "../src/tb_array.h"
+#include "../src/tb_hashmap.h"
+
+#include "bench.h"
+
+/*
+ * Benchmarks for tb_arena against malloc/free on a simulated request: many small blocks,
+ * a growing tb_array and a tb_hashmap, all released at the end of the request.
+ *
+ * usage: bench_mem [options]
+ *   -n <n>      small allocations per request (default 1000)
+ *   -k <n>      hashmap entries per request (default 64)
+ *   -r <n>      rounds per benchmark (default 15)
+ *   -f <fmt>    output format: json or csv (default json)
+ */
+
+typedef struct
+{
+    int allocs;
+    int entries;
+    int rounds;
+    int csv_output;
+} bench_config;
+
+typedef struct
+{
+    size_t allocs;
+    size_t entries;
+    size_t* sizes;
+    char (*keys)[24];
+    void** blocks;
+    tb_arena arena;
+    volatile size_t sink;
+} bench_state;
+
+static size_t bench_hash(const void* key) { return tb_hash_string(key); }
+static int    bench_cmp(const void* left, const void* right) { return strcmp(left, right); }
+
+/* ----------------------------| Requests |--------------------------------------------------------- */
+static void bench_request_heap(void* arg)
+{
+    bench_state* state = arg;
+
+    for (size_t i = 0; i < state->allocs; ++i)
+    {
+        state->blocks[i] = malloc(state->sizes[i]);
+        memset(state->blocks[i], (int)i, state->sizes[i]);
+    }
+
+    int* values = NULL;
+    for (size_t i = 0; i < state->allocs; ++i) tb_array_push(values, (int)i);
+
+    tb_hashmap map;
+    memset(&map, 0, sizeof(map));
+    tb_hashmap_init(&map, bench_hash, bench_cmp, 0);
+
+    for (size_t i = 0; i < state->entries; ++i) tb_hashmap_insert(&map, state->keys[i], state->blocks[i]);
+
+    state->sink += tb_array_len(values) + map.used;
+
+    tb_hashmap_destroy(&map);
+    tb_array_free(values);
+    for (size_t i = 0; i < state->allocs; ++i) free(state->blocks[i]);
+}
+
+static void bench_request_arena(void* arg)
+{
+    bench_state* state = arg;
+    tb_arena* arena = &state->arena;
+
+    for (size_t i = 0; i < state->allocs; ++i)
+    {
+        state->blocks[i] = tb_arena_alloc(arena, state->sizes[i]);
+        memset(state->blocks[i], (int)i, state->sizes[i]);
+    }
+
+    /* the array is the last allocation while it grows, so it grows in place */
+    tb_arena* prev = tb_arena_bind(arena);
+
+    int* values = NULL;
+    tb_array_create(values, 0, tb_arena_allocator());
+    for (size_t i = 0; i < state->allocs; ++i) tb_array_push(values, (int)i);
+
+    tb_arena_bind(prev);
+
+    tb_hashmap map;
+    memset(&map, 0, sizeof(map));
+    map.allocator = arena;
+    map.alloc = tb_arena_hashmap_alloc;
+    map.free = tb_arena_hashmap_free;
+    tb_hashmap_init(&map, bench_hash, bench_cmp, 0);
+
+    for (size_t i = 0; i < state->entries; ++i) tb_hashmap_insert(&map, state->keys[i], state->blocks[i]);
+
+    state->sink += tb_array_len(values) + map.used;
+
+    /* everything is released at once */
+    tb_arena_reset(arena);
+}
+
+/* temporary allocations inside a request, the block escapes so the heap pair is not optimized away */
+static void bench_scratch_arena(void* arg)
+{
+    bench_state* state = arg;
+    tb_arena* arena = &state->arena;
+
+    for (size_t i = 0; i < state->allocs; ++i)
+    {
+        tb_arena_marker marker = tb_arena_save(arena);
+
+        char* scratch = tb_arena_alloc(arena, state->sizes[i]);
+        scratch[0] = (char)i;
+        state->blocks[i] = scratch;
+
+        tb_arena_restore(arena, marker);
+    }
+}
+
+static void bench_scratch_heap(void* arg)
+{
+    bench_state* state = arg;
+
+    for (size_t i = 0; i < state->allocs; ++i)
+    {
+        char* scratch = malloc(state->sizes[i]);
+        scratch[0] = (char)i;
+        state->blocks[i] = scratch;
+
+        free(scratch);
+    }
+}
+
+static int bench_parse_args(bench_config* config, int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 >= argc) return 1;
+
+        const char* value = argv[++i];
+        switch (argv[i - 1][1])
+        {
+        case 'n': config->allocs = atoi(value); break;
+        case 'k': config->entries = atoi(value); break;
+        case 'r': config->rounds = atoi(value); break;
+        case 'f': config->csv_output = strcmp(value, "csv") == 0; break;
+        default: return 1;
+        }
+    }
+
+    return config->allocs < 1 || config->entries < 1 || config->entries > config->allocs || config->rounds < 1;
+}
+
+int main(int argc, char** argv)
+{
+    bench_config config = { 1000, 64, 15, 0 };
+    if (bench_parse_args(&config, argc, argv) != 0)
+    {
+        fprintf(stderr, "usage: %s [-n allocs] [-k entries (at most allocs)] [-r rounds] [-f json|csv]\n", argv[0]);
+        return 1;
+    }
+
+    bench_state state;
+    state.allocs = (size_t)config.allocs;
+    state.entries = (size_t)config.entries;
+    state.sizes = malloc(state.allocs * sizeof(size_t));
+    state.keys = malloc(state.entries * sizeof(*state.keys));
+    state.blocks = malloc(state.allocs * sizeof(void*));
+    state.sink = 0;
+
+    if (!state.sizes || !state.keys || !state.blocks) return 1;
+
+    /* small blocks between 16 and 256 bytes */
+    unsigned seed = 1;
+    for (size_t i = 0; i < state.allocs; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        state.sizes[i] = 16 + ((seed >> 16) % 241);
+    }
+    for (size_t i = 0; i < state.entries; ++i) snprintf(state.keys[i], sizeof(*state.keys), "key%zu", i);
+
+    tb_arena_init(&state.arena, 0, NULL);
+
+    bench_csv_output = config.csv_output;
+    if (bench_csv_output) printf("name,value,unit\n");
+
+    bench_report("allocs", config.allocs, "count");
+    bench_report("entries", config.entries, "count");
+
+    double heap = bench_measure(bench_request_heap, &state, config.rounds);
+    double arena = bench_measure(bench_request_arena, &state, config.rounds);
+
+    bench_report("request_heap", heap / 1e3, "us");
+    bench_report("request_arena", arena / 1e3, "us");
+    bench_report("request_arena_speedup", heap / arena, "x");
+
+    double scratch_heap = bench_measure(bench_scratch_heap, &state, config.rounds);
+    double scratch_arena = bench_measure(bench_scratch_arena, &state, config.rounds);
+
+    bench_report("scratch_heap", scratch_heap / config.allocs, "ns");
+    bench_report("scratch_arena", scratch_arena / config.allocs, "ns");
+
+    bench_report_rss();
+
+    tb_arena_destroy(&state.arena);
+    free(state.sizes);
+    free(state.keys);
+    free(state.blocks);
+
+    return 0;
+}
@@ -0,0 +1,421 @@
+#include "../src/tb_queue.h"
+#include "../src/tb_array.h"
+
+#include "bench.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+/*
+ * Throughput and latency of tb_spsc and tb_mpmc across thread counts, compared to a
+ * mutex-protected tb_array used as a queue. Throughput is measured with one producer and one
+ * consumer and with up to -t of each, latency as the round trip of a single item between two
+ * threads. On fewer cores than threads the numbers mostly show the cost of context switches.
+ *
+ * usage: bench_queue [options]
+ *   -n <n>      number of items per run (default 1000000)
+ *   -b <n>      batch size of the enqueues and dequeues (default 32)
+ *   -t <n>      maximum number of producer and consumer threads each (default 4)
+ *   -q <n>      queue capacity (default 1024)
+ *   -p <n>      number of round trips of the latency benchmark (default 20000)
+ *   -r <n>      rounds per benchmark, the median is reported (default 5)
+ *   -f <fmt>    output format: json or csv (default json)
+ */
+
+typedef struct
+{
+    int items;
+    int batch;
+    int threads;
+    int capacity;
+    int pings;
+    int rounds;
+    int csv_output;
+} bench_config;
+
+/* ----------------------------| Queues |----------------------------------------------------------- */
+typedef size_t (*bench_queue_func)(void* queue, void* items, size_t n);
+
+typedef struct
+{
+    const char* name;
+    void* (*create)(size_t capacity);
+    void  (*destroy)(void* queue);
+    bench_queue_func enqueue;
+    bench_queue_func dequeue;
+} bench_queue_type;
+
+static void*  bench_spsc_create(size_t capacity)                 { return tb_spsc_create(capacity, sizeof(size_t)); }
+static void   bench_spsc_destroy(void* queue)                    { tb_spsc_destroy(queue); }
+static size_t bench_spsc_enqueue(void* queue, void* items, size_t n) { return tb_spsc_enqueue(queue, items, n); }
+static size_t bench_spsc_dequeue(void* queue, void* items, size_t n) { return tb_spsc_dequeue(queue, items, n); }
+
+static void*  bench_mpmc_create(size_t capacity)                 { return tb_mpmc_create(capacity, sizeof(size_t)); }
+static void   bench_mpmc_destroy(void* queue)                    { tb_mpmc_destroy(queue); }
+static size_t bench_mpmc_enqueue(void* queue, void* items, size_t n) { return tb_mpmc_enqueue(queue, items, n); }
+static size_t bench_mpmc_dequeue(void* queue, void* items, size_t n) { return tb_mpmc_dequeue(queue, items, n); }
+
+/* the baseline: a bounded queue in a tb_array behind a mutex */
+typedef struct
+{
+    pthread_mutex_t mutex;
+    size_t* items;
+    size_t capacity;
+} bench_locked;
+
+static void* bench_locked_create(size_t capacity)
+{
+    bench_locked* queue = malloc(sizeof(bench_locked));
+    if (!queue) return NULL;
+
+    pthread_mutex_init(&queue->mutex, NULL);
+    queue->items = NULL;
+    queue->capacity = capacity;
+    tb_array_reserve(queue->items, capacity);
+
+    return queue;
+}
+
+static void bench_locked_destroy(void* arg)
+{
+    bench_locked* queue = arg;
+    pthread_mutex_destroy(&queue->mutex);
+    tb_array_free(queue->items);
+    free(queue);
+}
+
+static size_t bench_locked_enqueue(void* arg, void* items, size_t n)
+{
+    bench_locked* queue = arg;
+    pthread_mutex_lock(&queue->mutex);
+
+    size_t room = queue->capacity - tb_array_len(queue->items);
+    if (n > room) n = room;
+    tb_array_append_n(queue->items, (size_t*)items, n);
+
+    pthread_mutex_unlock(&queue->mutex);
+    return n;
+}
+
+static size_t bench_locked_dequeue(void* arg, void* items, size_t n)
+{
+    bench_locked* queue = arg;
+    pthread_mutex_lock(&queue->mutex);
+
+    size_t len = tb_array_len(queue->items);
+    if (n > len) n = len;
+    memcpy(items, queue->items, n * sizeof(size_t));
+    tb_array_erase_n(queue->items, 0, n);
+
+    pthread_mutex_unlock(&queue->mutex);
+    return n;
+}
+
+static const bench_queue_type bench_spsc = { "spsc", bench_spsc_create, bench_spsc_destroy, bench_spsc_enqueue, bench_spsc_dequeue };
+static const bench_queue_type bench_mpmc = { "mpmc", bench_mpmc_create, bench_mpmc_destroy, bench_mpmc_enqueue, bench_mpmc_dequeue };
+static const bench_queue_type bench_locked_array = { "locked_array", bench_locked_create, bench_locked_destroy, bench_locked_enqueue, bench_locked_dequeue };
+
+/* ----------------------------| Throughput |------------------------------------------------------- */
+typedef struct
+{
+    const bench_queue_type* type;
+    void* queue;
+    size_t items;       /* per producer */
+    size_t total;
+    size_t batch;
+    atomic_size_t consumed;
+    atomic_size_t checksum;
+    atomic_int ready;
+    int threads;
+} bench_run;
+
+/* all threads start at once, on fewer cores than threads the spinning threads yield */
+static void bench_wait_start(bench_run* run)
+{
+    atomic_fetch_add(&run->ready, 1);
+    while (atomic_load(&run->ready) < run->threads) sched_yield();
+}
+
+static void* bench_producer(void* arg)
+{
+    bench_run* run = arg;
+    size_t* items = malloc(run->batch * sizeof(size_t));
+    if (!items) return NULL;
+
+    bench_wait_start(run);
+
+    size_t sent = 0;
+    while (sent < run->items)
+    {
+        size_t n = (run->items - sent < run->batch) ? run->items - sent : run->batch;
+        for (size_t i = 0; i < n; ++i) items[i] = sent + i;
+
+        size_t done = 0;
+        while (done < n)
+        {
+            size_t k = run->type->enqueue(run->queue, items + done, n - done);
+            if (!k) sched_yield();
+            done += k;
+        }
+        sent += n;
+    }
+
+    free(items);
+    return NULL;
+}
+
+static void* bench_consumer(void* arg)
+{
+    bench_run* run = arg;
+    size_t* items = malloc(run->batch * sizeof(size_t));
+    if (!items) return NULL;
+
+    bench_wait_start(run);
+
+    size_t sum = 0;
+    while (atomic_load_explicit(&run->consumed, memory_order_relaxed) < run->total)
+    {
+        size_t k = run->type->dequeue(run->queue, items, run->batch);
+        if (!k)
+        {
+            sched_yield();
+            continue;
+        }
+
+        for (size_t i = 0; i < k; ++i) sum += items[i];
+        atomic_fetch_add_explicit(&run->consumed, k, memory_order_relaxed);
+    }
+
+    atomic_fetch_add(&run->checksum, sum);
+    free(items);
+    return NULL;
+}
+
+/* returns the throughput in million items per second, or 0 if a run failed */
+static double bench_throughput(const bench_queue_type* type, const bench_config* config, int producers, int consumers, size_t batch)
+{
+    double* samples = malloc(config->rounds * sizeof(double));
+    pthread_t* threads = malloc((producers + consumers) * sizeof(pthread_t));
+    if (!samples || !threads)
+    {
+        free(samples);
+        free(threads);
+        return 0.0;
+    }
+
+    bench_run run;
+    run.type = type;
+    run.items = (size_t)config->items / producers;
+    run.total = run.items * producers;
+    run.batch = batch;
+    run.threads = producers + consumers;
+
+    int failed = 0;
+    for (int r = 0; r < config->rounds && !failed; ++r)
+    {
+        run.queue = type->create(config->capacity);
+        if (!run.queue)
+        {
+            failed = 1;
+            break;
+        }
+
+        atomic_init(&run.consumed, 0);
+        atomic_init(&run.checksum, 0);
+        atomic_init(&run.ready, 0);
+
+        double start = bench_now_ns();
+        for (int i = 0; i < producers; ++i) pthread_create(&threads[i], NULL, bench_producer, &run);
+        for (int i = 0; i < consumers; ++i) pthread_create(&threads[producers + i], NULL, bench_consumer, &run);
+        for (int i = 0; i < producers + consumers; ++i) pthread_join(threads[i], NULL);
+        samples[r] = bench_now_ns() - start;
+
+        /* every producer sends 0 .. items - 1 */
+        size_t expected = producers * (run.items * (run.items - 1) / 2);
+        if (atomic_load(&run.checksum) != expected) failed = 1;
+
+        type->destroy(run.queue);
+    }
+
+    double median = 0.0;
+    if (!failed)
+    {
+        qsort(samples, config->rounds, sizeof(double), bench_cmp_double);
+        median = samples[config->rounds / 2];
+    }
+
+    free(samples);
+    free(threads);
+
+    return failed ? 0.0 : run.total / (median / 1e9) / 1e6;
+}
+
+/* ----------------------------| Uncontended |------------------------------------------------------ */
+typedef struct
+{
+    const bench_queue_type* type;
+    void* queue;
+    size_t* items;
+    size_t batch;
+} bench_uncontended;
+
+/* one batch through the queue on a single thread, the cost without any contention */
+static void bench_uncontended_batch(void* arg)
+{
+    bench_uncontended* state = arg;
+    state->type->enqueue(state->queue, state->items, state->batch);
+    state->type->dequeue(state->queue, state->items, state->batch);
+}
+
+/* returns the time per item in ns */
+static double bench_uncontended_item(const bench_queue_type* type, const bench_config* config)
+{
+    bench_uncontended state = { type, type->create(config->capacity), calloc(config->batch, sizeof(size_t)), (size_t)config->batch };
+
+    double ns = 0.0;
+    if (state.queue && state.items) ns = bench_measure(bench_uncontended_batch, &state, config->rounds) / config->batch;
+
+    if (state.queue) type->destroy(state.queue);
+    free(state.items);
+
+    return ns;
+}
+
+/* ----------------------------| Latency |---------------------------------------------------------- */
+typedef struct
+{
+    const bench_queue_type* type;
+    void* ping;
+    void* pong;
+    size_t count;
+} bench_pingpong;
+
+static void* bench_ponger(void* arg)
+{
+    bench_pingpong* state = arg;
+
+    for (size_t i = 0; i < state->count; ++i)
+    {
+        size_t item;
+        while (!state->type->dequeue(state->ping, &item, 1)) sched_yield();
+        while (!state->type->enqueue(state->pong, &item, 1)) sched_yield();
+    }
+
+    return NULL;
+}
+
+/* returns the median round trip time in ns of a single item sent to another thread and back */
+static double bench_latency(const bench_queue_type* type, const bench_config* config)
+{
+    bench_pingpong state = { type, type->create(config->capacity), type->create(config->capacity), (size_t)config->pings };
+    double* samples = malloc(config->pings * sizeof(double));
+
+    double median = 0.0;
+    pthread_t thread;
+    if (state.ping && state.pong && samples && pthread_create(&thread, NULL, bench_ponger, &state) == 0)
+    {
+        for (int i = 0; i < config->pings; ++i)
+        {
+            size_t item = (size_t)i;
+            double start = bench_now_ns();
+
+            while (!type->enqueue(state.ping, &item, 1)) sched_yield();
+            while (!type->dequeue(state.pong, &item, 1)) sched_yield();
+
+            samples[i] = bench_now_ns() - start;
+        }
+        pthread_join(thread, NULL);
+
+        qsort(samples, config->pings, sizeof(double), bench_cmp_double);
+        median = samples[config->pings / 2];
+    }
+
+    if (state.ping) type->destroy(state.ping);
+    if (state.pong) type->destroy(state.pong);
+    free(samples);
+
+    return median;
+}
+
+static int bench_parse_args(bench_config* config, int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 >= argc) return 1;
+
+        const char* value = argv[++i];
+        switch (argv[i - 1][1])
+        {
+        case 'n': config->items = atoi(value); break;
+        case 'b': config->batch = atoi(value); break;
+        case 't': config->threads = atoi(value); break;
+        case 'q': config->capacity = atoi(value); break;
+        case 'p': config->pings = atoi(value); break;
+        case 'r': config->rounds = atoi(value); break;
+        case 'f': config->csv_output = strcmp(value, "csv") == 0; break;
+        default: return 1;
+        }
+    }
+
+    return config->items < 1 || config->batch < 1 || config->threads < 1 || config->capacity < 1 || config->pings < 1 || config->rounds < 1;
+}
+
+int main(int argc, char** argv)
+{
+    bench_config config = { 1000000, 32, 4, 1024, 20000, 5, 0 };
+    if (bench_parse_args(&config, argc, argv) != 0)
+    {
+        fprintf(stderr, "usage: %s [-n items] [-b batch] [-t threads] [-q capacity] [-p pings] [-r rounds] [-f json|csv]\n", argv[0]);
+        return 1;
+    }
+
+    bench_csv_output = config.csv_output;
+    if (bench_csv_output) printf("name,value,unit\n");
+
+    bench_report("items", config.items, "count");
+    bench_report("batch", config.batch, "count");
+    bench_report("capacity", config.capacity, "count");
+
+    char name[64];
+    const bench_queue_type* types[] = { &bench_spsc, &bench_mpmc, &bench_locked_array };
+
+    for (size_t t = 0; t < 3; ++t)
+    {
+        snprintf(name, sizeof(name), "%s_uncontended", types[t]->name);
+        bench_report(name, bench_uncontended_item(types[t], &config), "ns/item");
+    }
+
+    /* one producer and one consumer, single items and batches */
+    for (size_t t = 0; t < 3; ++t)
+    {
+        snprintf(name, sizeof(name), "%s_1x1_single", types[t]->name);
+        bench_report(name, bench_throughput(types[t], &config, 1, 1, 1), "Mitems/s");
+
+        snprintf(name, sizeof(name), "%s_1x1_batch", types[t]->name);
+        bench_report(name, bench_throughput(types[t], &config, 1, 1, config.batch), "Mitems/s");
+    }
+
+    /* more producers and consumers, only for the queues that support them */
+    for (size_t t = 1; t < 3; ++t)
+    {
+        for (int threads = 2; threads <= config.threads; threads *= 2)
+        {
+            snprintf(name, sizeof(name), "%s_%dx%d_batch", types[t]->name, threads, threads);
+            bench_report(name, bench_throughput(types[t], &config, threads, threads, config.batch), "Mitems/s");
+
+            snprintf(name, sizeof(name), "%s_%dx1_batch", types[t]->name, threads);
+            bench_report(name, bench_throughput(types[t], &config, threads, 1, config.batch), "Mitems/s");
+        }
+    }
+
+    for (size_t t = 0; t < 3; ++t)
+    {
+        snprintf(name, sizeof(name), "%s_round_trip", types[t]->name);
+        bench_report(name, bench_latency(types[t], &config), "ns");
+    }
+
+    bench_report_rss();
+
+    return 0;
+}
@@ -1,12 +1,34 @@
 #include "../src/tb_array.h"
 
 #include <stdio.h>
+#include <stdint.h>
 
 typedef struct
 {
     int id;
 } Element;
 
+/* allocator that counts the bytes it currently holds */
+static size_t allocated = 0;
+
+static void* counting_malloc(size_t size)
+{
+    allocated += size;
+    return malloc(size);
+}
+
+static void* counting_realloc(void* block, size_t old_size, size_t new_size)
+{
+    allocated += new_size - old_size;
+    return realloc(block, new_size);
+}
+
+static void counting_free(void* block, size_t size)
+{
+    allocated -= size;
+    free(block);
+}
+
 int main()
 {
     Element* array = NULL;
@@ -25,7 +47,87 @@ int main()
         printf("ID: %d\n", array[i].id);
     }
 
+    /* bulk operations */
+    Element more[3] = { { 100 }, { 101 }, { 102 } };
+    tb_array_insert_n(array, 2, more, 3);   /* 0 1 100 101 102 2 ... */
+    tb_array_erase_n(array, 0, 2);          /* 100 101 102 2 ... */
+    tb_array_swap_remove(array, 0);         /* 9 101 102 2 ... */
+
+    Element* slots = tb_array_add_uninit(array, 2);
+    slots[0].id = 200;
+    slots[1].id = 201;
+
+    for (size_t i = 0; i < tb_array_len(array); ++i)
+    {
+        printf("%d ", array[i].id);
+    }
+    printf("\n");
+
     tb_array_free(array);
 
+    /* arrays with an allocator */
+    tb_allocator allocator = { counting_malloc, counting_realloc, counting_free };
+
+    Element* counted = NULL;
+    tb_array_create(counted, 4, &allocator);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        e.id = i;
+        tb_array_push(counted, e);
+    }
+
+    printf("len: %zu, cap: %zu, allocated: %zu bytes\n", tb_array_len(counted), tb_array_cap(counted), allocated);
+
+    tb_array_free(counted);
+    printf("allocated after free: %zu bytes\n", allocated);
+
+    /* arrays aligned to a cache line */
+    float* aligned = NULL;
+    tb_array_create_aligned(aligned, 0, 64, NULL);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        float f = (float)i;
+        tb_array_push(aligned, f);
+    }
+
+    printf("aligned len: %zu, offset to 64 bytes: %zu\n", tb_array_len(aligned), (size_t)((uintptr_t)aligned % 64));
+
+    tb_array_free(aligned);
+
+    /* small arrays only allocate once they outgrow their inline storage */
+    tb_array_small(Element, 4) small = { 0 };
+
+    for (int i = 0; i < 6; ++i)
+    {
+        e.id = i;
+        tb_array_small_push(small, e);
+        printf("small len: %zu, cap: %zu, on heap: %d\n", tb_array_small_len(small), tb_array_small_cap(small), small.heap != NULL);
+    }
+
+    tb_array_small_free(small);
+
+    /* arrays stored in a file keep their content when they are closed */
+    Element* stored = NULL;
+    if (tb_array_file_open(stored, "demo_array.bin"))
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            e.id = 1000 + i;
+            tb_array_push(stored, e);
+        }
+
+        tb_array_file_flush(stored);
+        tb_array_file_close(stored);
+    }
+
+    if (tb_array_file_open(stored, "demo_array.bin"))
+    {
+        printf("reopened %zu stored elements, last: %d\n", tb_array_len(stored), stored[tb_array_len(stored) - 1].id);
+        tb_array_file_close(stored);
+    }
+    remove("demo_array.bin");
+
     return 0;
-}
\ No newline at end of file
+}
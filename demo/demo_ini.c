@@ -0,0 +1,133 @@
+#include "../src/tb_ini.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct
+{
+    char title[32];
+    int width;
+    int height;
+    int vsync;
+    float scale;
+    double gamma;
+    int64_t seed;
+    int threads;
+    int cache_size;
+    char log_file[64];
+    int log_level;
+    float volume;
+} config;
+
+#define CONFIG(X)                                                                   \
+    X(TB_INI_BIND_STRING(config, title,      "window", "title", "untitled"))        \
+    X(TB_INI_BIND_INT(config, width,         "window", "width", 800))               \
+    X(TB_INI_BIND_INT(config, height,        "window", "height", 600))              \
+    X(TB_INI_BIND_BOOL(config, vsync,        "window", "vsync", 0))                 \
+    X(TB_INI_BIND_FLOAT(config, scale,       "render", "scale", 1.0f))              \
+    X(TB_INI_BIND_DOUBLE(config, gamma,      "render", "gamma", 2.2))               \
+    X(TB_INI_BIND_INT64(config, seed,        "world", "seed", 0))                   \
+    X(TB_INI_BIND_INT(config, threads,       "engine", "threads", 1))               \
+    X(TB_INI_BIND_INT(config, cache_size,    "engine", "cache_size", 0))            \
+    X(TB_INI_BIND_STRING(config, log_file,   "log", "file", "log.txt"))             \
+    X(TB_INI_BIND_INT(config, log_level,     "log", "level", 0))                    \
+    X(TB_INI_BIND_FLOAT(config, volume,      "audio", "volume", 1.0f))
+
+#define BINDING(b) b,
+static const tb_ini_binding bindings[] = { CONFIG(BINDING) };
+
+#define BINDING_COUNT   (sizeof(bindings) / sizeof(bindings[0]))
+
+/* creates an ini with the config sections spread between lots of filler sections */
+static char* generate_ini(int filler_sections, int filler_props)
+{
+    const char* sections[] =
+    {
+        "[window]\ntitle = Demo\nwidth = 1920\nheight = 1080\nvsync = true\n",
+        "[render]\nscale = 1.5\ngamma = 2.4\n",
+        "[world]\nseed = 0x5eed\n",
+        "[engine]\nthreads = 8\ncache_size = 65536\n",
+        "[log]\nfile = demo.log\nlevel = 3\n",
+        "[audio]\nvolume = 0.75\ncurve = {0.0, 0.25, 0.5, 0.75, 1.0}\n"
+    };
+    size_t section_count = sizeof(sections) / sizeof(sections[0]);
+
+    size_t size = (size_t)filler_sections * (filler_props + 1) * 32 + 1024;
+    char* ini = malloc(size);
+    if (!ini) return NULL;
+
+    size_t len = 0;
+    for (int i = 0; i < filler_sections; ++i)
+    {
+        if (i % (filler_sections / section_count) == 0 && i / (filler_sections / section_count) < section_count)
+            len += sprintf(ini + len, "%s", sections[i / (filler_sections / section_count)]);
+
+        len += sprintf(ini + len, "[filler%d]\n", i);
+        for (int p = 0; p < filler_props; ++p)
+            len += sprintf(ini + len, "key%d = %d\n", p, p * i);
+    }
+
+    return ini;
+}
+
+static void per_key(char* ini, config* cfg)
+{
+    tb_ini_string(ini, "window", "title", cfg->title, sizeof(cfg->title));
+    cfg->width = tb_ini_int(ini, "window", "width", 800);
+    cfg->height = tb_ini_int(ini, "window", "height", 600);
+    cfg->vsync = tb_ini_bool(ini, "window", "vsync", 0);
+    cfg->scale = tb_ini_float(ini, "render", "scale", 1.0f);
+    cfg->gamma = tb_ini_double(ini, "render", "gamma", 2.2);
+    cfg->seed = tb_ini_int64(ini, "world", "seed", 0);
+    cfg->threads = tb_ini_int(ini, "engine", "threads", 1);
+    cfg->cache_size = tb_ini_int(ini, "engine", "cache_size", 0);
+    tb_ini_string(ini, "log", "file", cfg->log_file, sizeof(cfg->log_file));
+    cfg->log_level = tb_ini_int(ini, "log", "level", 0);
+    cfg->volume = tb_ini_float(ini, "audio", "volume", 1.0f);
+}
+
+int main()
+{
+    char* ini = generate_ini(6000, 20);
+    if (!ini) return 1;
+
+    const int runs = 20;
+    config a, b;
+
+    clock_t start = clock();
+    for (int i = 0; i < runs; ++i) per_key(ini, &a);
+    double per_key_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC / runs;
+
+    size_t found = 0;
+    tb_ini_error errors[BINDING_COUNT];
+
+    start = clock();
+    for (int i = 0; i < runs; ++i) found = tb_ini_bind(ini, bindings, BINDING_COUNT, &b, errors);
+    double bind_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC / runs;
+
+    printf("ini size:   %zu bytes\n", strlen(ini));
+    printf("per key:    %.3f ms\n", per_key_ms);
+    printf("bind:       %.3f ms (%zu of %zu found)\n", bind_ms, found, BINDING_COUNT);
+
+    for (size_t i = 0; i < BINDING_COUNT; ++i)
+        if (errors[i] != TB_INI_OK) printf("%s.%s: %s\n", bindings[i].section, bindings[i].prop, tb_ini_get_error_desc(errors[i]));
+
+    printf("title: %s, size: %dx%d, vsync: %d, scale: %.2f, gamma: %.2f, seed: %lld\n",
+        b.title, b.width, b.height, b.vsync, b.scale, b.gamma, (long long)b.seed);
+    printf("threads: %d, cache: %d, log: %s (%d), volume: %.2f\n",
+        b.threads, b.cache_size, b.log_file, b.log_level, b.volume);
+    printf("results match: %s\n", (a.width == b.width && a.seed == b.seed && a.volume == b.volume && strcmp(a.log_file, b.log_file) == 0) ? "yes" : "no");
+
+    float curve[8];
+    tb_ini_element element;
+    size_t points = tb_ini_csv_to_float_array(ini, "audio", "curve", curve, 8, &element);
+
+    if (element.error != TB_INI_OK) printf("audio.curve: %s at value %zu\n", tb_ini_get_error_desc(element.error), points);
+    else                            printf("curve: %zu points, last %.2f\n", points, curve[points - 1]);
+
+    free(ini);
+
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include "../src/tb_ini_edit.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char* ini =
+    "; window settings\n"
+    "[window]\n"
+    "title  = Demo      ; shown in the title bar\n"
+    "width  = 1024\n"
+    "height = 768\n"
+    "\n"
+    "; audio settings\n"
+    "[audio]\n"
+    "volume = 0.5\n";
+
+int main()
+{
+    tb_ini_edit edit;
+    tb_ini_edit_init(&edit, ini, strlen(ini));
+
+    tb_ini_edit_set(&edit, "window", "width", "1920");
+    tb_ini_edit_set(&edit, "window", "height", "1080");
+    tb_ini_edit_set(&edit, "window", "vsync", "true");
+    tb_ini_edit_remove(&edit, "audio", "volume");
+    tb_ini_edit_set(&edit, "audio", "muted", "true");
+    tb_ini_edit_set(&edit, "network", "port", "8080");
+
+    char buf[512];
+    tb_ini_edit_render(&edit, buf, sizeof(buf));
+
+    printf("%s", buf);
+    printf("--\n%zu patches, %zu bytes\n", edit.patch_count, tb_ini_edit_size(&edit));
+
+    tb_ini_error error = tb_ini_edit_save(&edit, "demo_edit.ini");
+    printf("save: %s\n", tb_ini_get_error_desc(error));
+
+    remove("demo_edit.ini");
+    tb_ini_edit_destroy(&edit);
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "../src/tb_ini_index.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* creates an ini with sections * props properties */
+static char* generate_ini(int sections, int props, size_t* len)
+{
+    char* ini = malloc((size_t)sections * (props + 1) * 32 + 64);
+    if (!ini) return NULL;
+
+    *len = sprintf(ini, "name = index demo\n");
+    for (int s = 0; s < sections; ++s)
+    {
+        *len += sprintf(ini + *len, "[section%d]\n", s);
+        for (int p = 0; p < props; ++p)
+            *len += sprintf(ini + *len, "key%d = %d\n", p, s * props + p);
+    }
+
+    return ini;
+}
+
+static double now_ms()
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+int main()
+{
+    size_t len;
+    char* ini = generate_ini(100000, 20, &len);
+    if (!ini) return 1;
+
+    printf("ini size: %zu bytes\n", len);
+
+    for (size_t chunks = 1; chunks <= 8; chunks *= 2)
+    {
+        tb_ini_index index;
+
+        double start = now_ms();
+        tb_ini_error error = tb_ini_index_build(&index, ini, len, chunks, tb_ini_run_threads, NULL);
+        double build_ms = now_ms() - start;
+
+        if (error != TB_INI_OK)
+        {
+            printf("Failed to build index: %s\n", tb_ini_get_error_desc(error));
+            break;
+        }
+
+        printf("%zu chunk(s): %8.3f ms (%zu sections, %zu properties)\n", chunks, build_ms, index.section_count, index.prop_count);
+        tb_ini_index_destroy(&index);
+    }
+
+    tb_ini_index index;
+    if (tb_ini_index_build(&index, ini, len, 4, tb_ini_run_threads, NULL) == TB_INI_OK)
+    {
+        char name[32];
+        tb_ini_index_string(&index, NULL, "name", name, 32);
+
+        printf("name: %s\n", name);
+        printf("section99999.key19: %d\n", tb_ini_index_int(&index, "section99999", "key19", -1));
+        printf("section5.missing: %d\n", tb_ini_index_int(&index, "section5", "missing", -1));
+
+        /* change a single value in a copy and update the index from the previous one */
+        char* edited = malloc(len + 1);
+        if (edited)
+        {
+            memcpy(edited, ini, len + 1);
+            memcpy(strstr(edited, "[section50000]\nkey0 = ") + 22, "7", 1);
+
+            tb_ini_index updated;
+            double start = now_ms();
+            tb_ini_index_update(&updated, &index, edited, len);
+            double update_ms = now_ms() - start;
+
+            printf("update:     %8.3f ms (%zu changes)\n", update_ms, tb_ini_index_diff(&index, &updated, NULL, NULL));
+            printf("section50000.key0: %d\n", tb_ini_index_int(&updated, "section50000", "key0", -1));
+
+            tb_ini_index_destroy(&updated);
+            free(edited);
+        }
+
+        tb_ini_index_destroy(&index);
+    }
+
+    free(ini);
+
+    return 0;
+}
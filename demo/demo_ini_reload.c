@@ -0,0 +1,61 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../src/tb_ini_reload.h"
+
+#include <stdio.h>
+#include <time.h>
+
+static const char* path = "demo_reload.ini";
+
+static void write_config(int width)
+{
+    FILE* file = fopen(path, "w");
+    if (!file) return;
+
+    fprintf(file, "[window]\ntitle = Reload\nwidth = %d\n", width);
+    fclose(file);
+}
+
+static void on_change(void* user, tb_ini_change change, const tb_ini_element* section, const tb_ini_element* prop)
+{
+    const char* names[] = { "added", "removed", "modified" };
+    if (prop) printf("  %s: %.*s.%.*s = %.*s\n", names[change], (int)section->name_len, section->name, (int)prop->name_len, prop->name, (int)prop->len, prop->start);
+}
+
+static void on_reload(void* user, const tb_ini_config* old, const tb_ini_config* config)
+{
+    printf("reloaded: version %llu -> %llu\n", (unsigned long long)old->version, (unsigned long long)config->version);
+    tb_ini_index_diff(&old->index, &config->index, on_change, NULL);
+}
+
+int main()
+{
+    write_config(800);
+
+    tb_ini_error error;
+    tb_ini_reload* reload = tb_ini_reload_open(path, 1, on_reload, NULL, &error);
+    if (!reload)
+    {
+        printf("Failed to open config: %s\n", tb_ini_get_error_desc(error));
+        return 1;
+    }
+
+    for (int i = 1; i <= 3; ++i)
+    {
+        write_config(800 + i * 100);
+
+        struct timespec delay = { 0, 100 * 1000000 };
+        nanosleep(&delay, NULL);
+
+        /* readers never block, the config stays valid until it is released */
+        unsigned token;
+        const tb_ini_config* config = tb_ini_reload_acquire(reload, &token);
+        printf("width: %d\n", tb_ini_index_int(&config->index, "window", "width", 0));
+        tb_ini_reload_release(reload, token);
+    }
+
+    tb_ini_reload_close(reload);
+    remove(path);
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include "../src/tb_ini_snapshot.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* ini =
+    "[window]\n"
+    "title = Demo\n"
+    "width = 1024\n"
+    "height = 768\n"
+    "vsync = true\n"
+    "[render]\n"
+    "scale = 1.5\n";
+
+int main()
+{
+    size_t size;
+    tb_ini_error error;
+    void* data = tb_ini_snapshot_compile(ini, strlen(ini), 0, &size, &error);
+
+    if (!data)
+    {
+        printf("Failed to compile snapshot: %s\n", tb_ini_get_error_desc(error));
+        return 1;
+    }
+
+    /* the snapshot could be written to a file and memory mapped on the next start */
+    tb_ini_snapshot snapshot;
+    tb_ini_snapshot_open(&snapshot, data, size);
+
+    char title[32];
+    tb_ini_snapshot_string(&snapshot, "window", "title", title, 32);
+
+    printf("Snapshot size: %zu bytes\n", size);
+    printf("Title: %s\n", title);
+    printf("Size: %dx%d\n", tb_ini_snapshot_int(&snapshot, "window", "width", 0), tb_ini_snapshot_int(&snapshot, "window", "height", 0));
+    printf("VSync: %d\n", tb_ini_snapshot_bool(&snapshot, "window", "vsync", 0));
+    printf("Scale: %f\n", tb_ini_snapshot_float(&snapshot, "render", "scale", 1.0f));
+    printf("Stale: %d\n", tb_ini_snapshot_stale(&snapshot, 1, ini, strlen(ini)));
+
+    free(data);
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "../src/tb_json.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* config =
+    "{\n"
+    "    \"name\": \"caf\\u00e9 server\",\n"
+    "    \"debug\": false,\n"
+    "    \"timeout\": 2.5,\n"
+    "    \"servers\": [\n"
+    "        { \"host\": \"alpha.local\", \"ports\": [8080, 8081] },\n"
+    "        { \"host\": \"beta.local\", \"ports\": [9090] }\n"
+    "    ],\n"
+    "    \"curve\": [0.0, 0.25, 0.5, 1.0]\n"
+    "}\n";
+
+int main()
+{
+    size_t len = strlen(config);
+
+    tb_json_element element;
+    if (tb_json_validate(config, len, &element) != TB_JSON_OK)
+    {
+        printf("Invalid json at %zu: %s\n", (size_t)(element.start - config), tb_json_get_error_desc(element.error));
+        return 1;
+    }
+
+    char name[32];
+    tb_json_string(config, len, "name", name, 32);
+
+    printf("name: %s\n", name);
+    printf("debug: %d\n", tb_json_bool(config, len, "debug", 1));
+    printf("timeout: %f\n", tb_json_double(config, len, "timeout", 0.0));
+    printf("servers[1].ports[0]: %d\n", tb_json_int(config, len, "servers[1].ports[0]", -1));
+    printf("servers[2].host: %d\n", tb_json_int(config, len, "servers[2].host", -1));
+
+    /* step over the members of each server */
+    tb_json_element servers, server, member;
+    tb_json_query(config, len, "servers", &servers);
+
+    const char* cursor = servers.start;
+    while ((cursor = tb_json_step(cursor, servers.start + servers.len - cursor, &server)))
+    {
+        printf("server:");
+
+        const char* inner = server.start;
+        while ((inner = tb_json_step(inner, server.start + server.len - inner, &member)))
+            printf(" %.*s = %.*s", (int)member.name_len, member.name, (int)member.len, member.start);
+
+        printf("\n");
+    }
+
+    /* queries relative to an element */
+    tb_json_element curve, value;
+    tb_json_query(config, len, "curve", &curve);
+    tb_json_query(curve.start, curve.len, "[3]", &value);
+
+    double d;
+    tb_json_element_to_double(&value, &d);
+    printf("curve has %zu values, curve[3]: %f\n", tb_json_count(&curve), d);
+
+    /* the structural index answers repeated queries without scanning the text again */
+    tb_json_index index;
+    if (tb_json_index_build(&index, config, len) == TB_JSON_OK)
+    {
+        tb_json_index_query(&index, "servers[0].host", &element);
+        printf("index servers[0].host: %.*s (%zu structurals)\n", (int)element.len, element.start, index.count);
+
+        tb_json_error error = tb_json_index_query(&index, "servers[0].missing", &element);
+        printf("index servers[0].missing: %s\n", tb_json_get_error_desc(error));
+
+        tb_json_index_destroy(&index);
+    }
+
+    return 0;
+}
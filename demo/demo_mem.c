@@ -0,0 +1,71 @@
+#include "../src/tb_mem.h"
+#include "../src/tb_array.h"
+#include "../src/tb_hashmap.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static size_t hash_string(const void* key) { return tb_hash_string(key); }
+static int    cmp_string(const void* left, const void* right) { return strcmp(left, right); }
+
+int main()
+{
+    tb_arena arena;
+    tb_arena_init(&arena, 1024, NULL);
+
+    /* bump allocations */
+    char* name = tb_arena_alloc(&arena, 16);
+    strcpy(name, "arena");
+
+    /* the last allocation grows in place */
+    char* line = tb_arena_alloc(&arena, 8);
+    strcpy(line, "grow");
+    char* grown = tb_arena_realloc(&arena, line, 8, 64);
+    strcat(grown, "n in place");
+    printf("%s: %s (%s)\n", name, grown, grown == line ? "same block" : "moved");
+
+    /* temporary allocations are released with a marker */
+    tb_arena_marker marker = tb_arena_save(&arena);
+    for (int i = 0; i < 100; ++i) tb_arena_alloc(&arena, 32);
+    tb_arena_restore(&arena, marker);
+
+    char* after = tb_arena_alloc(&arena, 8);
+    printf("after restore: %s\n", after == grown + 64 ? "memory reused" : "new memory");
+
+    /* tb_array through the arena bound to this thread */
+    tb_arena* prev = tb_arena_bind(&arena);
+
+    int* values = NULL;
+    tb_array_create(values, 4, tb_arena_allocator());
+    for (int i = 0; i < 10; ++i) tb_array_push(values, i * i);
+
+    tb_arena_bind(prev);
+
+    printf("values:");
+    for (size_t i = 0; i < tb_array_len(values); ++i) printf(" %d", values[i]);
+    printf("\n");
+
+    /* tb_hashmap with its tables in the arena */
+    tb_hashmap map;
+    memset(&map, 0, sizeof(map));
+    map.allocator = &arena;
+    map.alloc = tb_arena_hashmap_alloc;
+    map.free = tb_arena_hashmap_free;
+    tb_hashmap_init(&map, hash_string, cmp_string, 0);
+
+    tb_hashmap_insert(&map, "one", &values[1]);
+    tb_hashmap_insert(&map, "three", &values[3]);
+
+    int* three = tb_hashmap_find(&map, "three");
+    printf("three squared: %d\n", three ? *three : -1);
+
+    /* no single frees, everything goes at once */
+    tb_arena_reset(&arena);
+
+    char* reused = tb_arena_alloc(&arena, 16);
+    printf("after reset: %s\n", reused ? "ready for the next request" : "failed");
+
+    tb_arena_destroy(&arena);
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "../src/tb_queue.h"
+
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define ITEMS   1000
+#define WORKERS 3
+
+typedef struct
+{
+    int id;
+    int payload;
+} Job;
+
+static tb_spsc* results;
+static tb_mpmc* jobs;
+
+/* workers take jobs from the shared queue until they get a job with id -1 */
+static void* worker(void* arg)
+{
+    long sum = 0;
+    Job job;
+
+    for (;;)
+    {
+        if (!tb_mpmc_dequeue(jobs, &job, 1))
+        {
+            sched_yield();
+            continue;
+        }
+
+        if (job.id < 0) break;
+        sum += job.payload;
+    }
+
+    *(long*)arg = sum;
+    return NULL;
+}
+
+int main()
+{
+    /* single producer and consumer, batches move several elements at once */
+    results = tb_spsc_create(8, sizeof(int));
+
+    int values[5] = { 1, 2, 3, 4, 5 };
+    size_t n = tb_spsc_enqueue(results, values, 5);
+    printf("spsc enqueued %zu, len %zu, cap %zu\n", n, tb_spsc_len(results), tb_spsc_cap(results));
+
+    int out[8];
+    n = tb_spsc_dequeue(results, out, 8);
+    printf("spsc dequeued %zu: %d %d %d %d %d\n", n, out[0], out[1], out[2], out[3], out[4]);
+
+    tb_spsc_destroy(results);
+
+    /* job queue shared by several workers */
+    jobs = tb_mpmc_create(64, sizeof(Job));
+
+    pthread_t threads[WORKERS];
+    long sums[WORKERS];
+    for (int i = 0; i < WORKERS; ++i) pthread_create(&threads[i], NULL, worker, &sums[i]);
+
+    Job batch[16];
+    long expected = 0;
+    for (int i = 0; i < ITEMS; i += 16)
+    {
+        size_t count = 0;
+        for (int k = i; k < i + 16 && k < ITEMS; ++k)
+        {
+            Job job = { k, k * 2 };
+            batch[count++] = job;
+            expected += job.payload;
+        }
+
+        size_t done = 0;
+        while (done < count)
+        {
+            size_t added = tb_mpmc_enqueue(jobs, batch + done, count - done);
+            if (!added) sched_yield();
+            done += added;
+        }
+    }
+
+    for (int i = 0; i < WORKERS; ++i)
+    {
+        Job stop = { -1, 0 };
+        while (!tb_mpmc_enqueue(jobs, &stop, 1)) sched_yield();
+    }
+
+    long total = 0;
+    for (int i = 0; i < WORKERS; ++i)
+    {
+        pthread_join(threads[i], NULL);
+        total += sums[i];
+    }
+
+    printf("mpmc processed %d jobs, sum %ld (expected %ld)\n", ITEMS, total, expected);
+
+    tb_mpmc_destroy(jobs);
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "../src/tb_ring.h"
+
+#include <stdio.h>
+
+typedef struct
+{
+    int type;
+    int value;
+} Event;
+
+static void print_ring(const char* label, int* ring)
+{
+    printf("%s:", label);
+    for (size_t i = 0; i < tb_ring_len(ring); ++i) printf(" %d", tb_ring_at(ring, i));
+    printf(" (cap %zu)\n", tb_ring_cap(ring));
+}
+
+int main()
+{
+    /* event queue, dequeuing does not move the remaining events */
+    Event* events = NULL;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        Event e = { i % 2, i * 10 };
+        tb_ring_push_back(events, e);
+    }
+
+    while (!tb_ring_empty(events))
+    {
+        Event e = tb_ring_pop_front(events);
+        printf("event type %d, value %d\n", e.type, e.value);
+    }
+
+    tb_ring_free(events);
+
+    /* deque */
+    int* ring = NULL;
+
+    for (int i = 1; i <= 4; ++i)
+    {
+        tb_ring_push_back(ring, i);
+        tb_ring_push_front(ring, -i);
+    }
+    print_ring("deque", ring);
+
+    int front = tb_ring_pop_front(ring);
+    int back = tb_ring_pop_back(ring);
+    printf("pop front: %d, pop back: %d\n", front, back);
+    print_ring("deque", ring);
+
+    /* bulk operations copy at most two spans */
+    int values[5] = { 100, 101, 102, 103, 104 };
+    tb_ring_push_back_n(ring, values, 5);
+    print_ring("appended", ring);
+
+    printf("first span: %zu elements, second span: %zu elements\n", tb_ring_first_len(ring), tb_ring_second_len(ring));
+
+    int out[4];
+    size_t n = tb_ring_pop_front_n(ring, out, 4);
+    printf("read %zu: %d %d %d %d\n", n, out[0], out[1], out[2], out[3]);
+    print_ring("remaining", ring);
+
+    tb_ring_free(ring);
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include "../src/tb_segarray.h"
+
+#include <stdio.h>
+
+typedef struct
+{
+    int id;
+    float x, y;
+} Entity;
+
+int main()
+{
+    tb_segarray entities;
+    tb_segarray_init(&entities, sizeof(Entity), 16, NULL);
+
+    /* pointers to elements stay valid while the array grows */
+    Entity* first = NULL;
+    for (int i = 0; i < 100; ++i)
+    {
+        Entity e = { i, (float)i, (float)-i };
+        Entity* added = tb_segarray_push(&entities, &e);
+
+        if (i == 0) first = added;
+    }
+
+    printf("len: %zu, cap: %zu, chunks: %zu\n", tb_segarray_len(&entities), tb_segarray_cap(&entities), entities.chunk_count);
+    printf("first: %d (still at %p)\n", first->id, (void*)first);
+
+    Entity* e = tb_segarray_get(&entities, 42);
+    printf("entity 42: %f %f\n", e->x, e->y);
+
+    e = tb_segarray_get(&entities, 100);
+    printf("entity 100: %s\n", e ? "found" : "out of range");
+
+    /* removed chunks are recycled on growth */
+    tb_segarray_resize(&entities, 10);
+    printf("after resize len: %zu, cap: %zu\n", tb_segarray_len(&entities), tb_segarray_cap(&entities));
+
+    tb_segarray_shrink(&entities);
+    printf("after shrink cap: %zu\n", tb_segarray_cap(&entities));
+
+    tb_segarray_destroy(&entities);
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include "../src/tb_soa.h"
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define PARTICLE_FIELDS(X)  \
+    X(float, x)             \
+    X(float, y)             \
+    X(float, vx)            \
+    X(float, vy)            \
+    X(int, id)
+
+TB_SOA_DECLARE(particles, PARTICLE_FIELDS)
+
+int main()
+{
+    particles p = { 0 };
+
+    for (int i = 0; i < 10; ++i)
+        particles_push(&p, 0.0f, 0.0f, (float)i, 1.0f, i);
+
+    /* the update only streams the position and velocity columns */
+    for (int step = 0; step < 4; ++step)
+    {
+        for (size_t i = 0; i < p.len; ++i)
+        {
+            p.x[i] += p.vx[i] * 0.5f;
+            p.y[i] += p.vy[i] * 0.5f;
+        }
+    }
+
+    particles_swap_remove(&p, 2); /* particle 9 takes its place */
+
+    for (size_t i = 0; i < p.len; ++i)
+        printf("particle %d: %.1f %.1f\n", p.id[i], p.x[i], p.y[i]);
+
+    /* bulk growth, the new elements are uninitialized */
+    size_t first = p.len;
+    particles_resize(&p, first + 1000);
+
+    for (size_t i = first; i < p.len; ++i)
+    {
+        p.x[i] = p.y[i] = p.vx[i] = p.vy[i] = 0.0f;
+        p.id[i] = (int)i;
+    }
+
+    printf("len: %zu, cap: %zu, x aligned: %d, id aligned: %d\n", p.len, p.cap,
+        (uintptr_t)p.x % TB_SOA_ALIGN == 0, (uintptr_t)p.id % TB_SOA_ALIGN == 0);
+
+    particles_free(&p);
+
+    return 0;
+}
@@ -1,9 +1,95 @@
 #include "tb_array.h"
 
+#include <string.h>
+#include <stdint.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(MAP_ANON) && !defined(MAP_ANONYMOUS)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+#ifdef MAP_ANONYMOUS
+#define TB_ARRAY_MMAP
+#endif
+
+/* ftruncate is only declared for POSIX.1-2001 (on Linux _GNU_SOURCE or _POSIX_C_SOURCE) */
+#if defined(MAP_SHARED) && ((defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L) || defined(__APPLE__))
+#define TB_ARRAY_FILE
+#endif
+
+/*
+ * The second element of the extended header holds the alignment of the data (0 for the default
+ * alignment), its lower bits hold the padding in front of the extended header.
+ */
+static size_t tb_array__align(size_t ext)
+{
+    while (ext & (ext - 1)) ext &= ext - 1;
+    return ext;
+}
+
+/* padding in front of the extended header that aligns the data of block */
+static size_t tb_array__padding(const char* block, size_t align)
+{
+    if (!align) return 0;
+
+    uintptr_t data = (uintptr_t)(block + TB_ARRAY_EXT_SIZE + TB_ARRAY_HDR_SIZE);
+    return (align - (data & (align - 1))) & (align - 1);
+}
+
+static size_t tb_array__block_size(size_t cap, size_t elem_size, size_t align)
+{
+    return TB_ARRAY_EXT_SIZE + TB_ARRAY_HDR_SIZE + (align ? align - 1 : 0) + (cap * elem_size);
+}
+
+/* resize for arrays with an extended header */
+static void* tb_array__resize_ext(void* buf, size_t new_cap, size_t elem_size)
+{
+    TB_ARRAY_HDR_ELEM* ext = tb_array__hdr(buf) - 2;
+    tb_allocator* allocator = *(tb_allocator**)(void*)ext;
+
+    size_t align = tb_array__align(ext[1]);
+    size_t pad = align ? ext[1] & (align - 1) : 0;
+    size_t len = tb_array__len(buf);
+
+    char* block = (char*)ext - pad;
+    size_t old_size = tb_array__block_size(tb_array__cap(buf), elem_size, align);
+
+    if (new_cap == 0)
+    {
+        if (allocator && allocator->free)   allocator->free(block, old_size);
+        else                                free(block);
+        return NULL;
+    }
+
+    size_t new_size = tb_array__block_size(new_cap, elem_size, align);
+    block = (allocator && allocator->realloc) ? allocator->realloc(block, old_size, new_size) : realloc(block, new_size);
+
+    if (!block) return NULL; /* out of memory */
+
+    /* the new block can have a different alignment, the content then has to be moved */
+    size_t new_pad = tb_array__padding(block, align);
+    if (new_pad != pad)
+        memmove(block + new_pad, block + pad, TB_ARRAY_EXT_SIZE + TB_ARRAY_HDR_SIZE + ((len < new_cap) ? len : new_cap) * elem_size);
+
+    ext = (TB_ARRAY_HDR_ELEM*)(void*)(block + new_pad);
+    ext[1] = align | new_pad;
+    ext[2] = new_cap | TB_ARRAY_EXT_FLAG;
+
+    return ext + 4;
+}
+
 void* tb_array__resize(void* buf, size_t new_cap, size_t elem_size)
 {
     TB_ARRAY_HDR_ELEM* hdr = buf ? tb_array__hdr(buf) : NULL;
 
+    if (hdr && tb_array__ext(buf)) return tb_array__resize_ext(buf, new_cap, elem_size);
+
     if (hdr && new_cap == 0)
     {
         free(hdr);
@@ -37,4 +123,413 @@ void* tb_array__reserve(void* buf, size_t reserve, size_t elem_size)
 {
     if (buf && reserve < tb_array__cap(buf)) return buf;
     return tb_array__resize(buf, reserve, elem_size);
-}
\ No newline at end of file
+}
+
+void* tb_array__create(size_t cap, size_t elem_size, tb_allocator* allocator)
+{
+    return tb_array__create_aligned(cap, elem_size, 0, allocator);
+}
+
+void* tb_array__create_aligned(size_t cap, size_t elem_size, size_t align, tb_allocator* allocator)
+{
+    if (!allocator && !align) return tb_array__resize(NULL, cap, elem_size);
+
+    /* the headers in front of the data need at least their own alignment */
+    if (align && align < TB_ARRAY_HDR_SIZE) align = TB_ARRAY_HDR_SIZE;
+
+    size_t size = tb_array__block_size(cap, elem_size, align);
+    char* block = (allocator && allocator->malloc) ? allocator->malloc(size) : malloc(size);
+
+    if (!block) return NULL; /* out of memory */
+
+    size_t pad = tb_array__padding(block, align);
+    TB_ARRAY_HDR_ELEM* ext = (TB_ARRAY_HDR_ELEM*)(void*)(block + pad);
+
+    *(tb_allocator**)(void*)ext = allocator;
+    ext[1] = align | pad;
+    ext[2] = cap | TB_ARRAY_EXT_FLAG;
+    ext[3] = 0;
+
+    return ext + 4;
+}
+
+void* tb_array__insert(void* buf, size_t index, const void* src, size_t n, size_t elem_size)
+{
+    if (n == 0) return buf;
+
+    size_t len = tb_array_len(buf);
+
+    /* src may point into the array, which can move on growth */
+    const char* base = buf;
+    int alias = buf && src && (const char*)src >= base && (const char*)src < base + (len * elem_size);
+    size_t src_index = alias ? (size_t)((const char*)src - base) / elem_size : 0;
+
+    buf = tb_array__grow(buf, n, elem_size);
+    if (!buf) return NULL; /* out of memory */
+
+    char* data = buf;
+    char* dst = data + (index * elem_size);
+    memmove(dst + (n * elem_size), dst, (len - index) * elem_size);
+    tb_array__len(buf) = len + n;
+
+    if (!src) return buf;
+
+    if (!alias)
+    {
+        memcpy(dst, src, n * elem_size);
+        return buf;
+    }
+
+    /* the part of the source behind index got moved by n elements */
+    size_t before = (src_index < index) ? index - src_index : 0;
+    if (before > n) before = n;
+
+    memcpy(dst, data + (src_index * elem_size), before * elem_size);
+    memcpy(dst + (before * elem_size), data + ((src_index + before + n) * elem_size), (n - before) * elem_size);
+
+    return buf;
+}
+
+void tb_array__erase(void* buf, size_t index, size_t n, size_t elem_size)
+{
+    if (!buf || n == 0) return;
+
+    char* dst = (char*)buf + (index * elem_size);
+    memmove(dst, dst + (n * elem_size), (tb_array__len(buf) - index - n) * elem_size);
+    tb_array__len(buf) -= n;
+}
+
+/* ----------------------------| Small arrays |----------------------------------------------------- */
+int tb_array__small_grow(void** heap, size_t* cap, const void* local, size_t local_cap, size_t len, size_t increment, size_t elem_size)
+{
+    size_t old_cap = *heap ? *cap : local_cap;
+    if (len + increment <= old_cap) return 1;
+
+    size_t new_cap = 2 * old_cap;
+    if (new_cap < len + increment) new_cap = len + increment;
+
+    void* block = realloc(*heap, new_cap * elem_size);
+    if (!block) return 0; /* out of memory */
+
+    /* spilling from the inline storage */
+    if (!*heap) memcpy(block, local, len * elem_size);
+
+    *heap = block;
+    *cap = new_cap;
+
+    return 1;
+}
+
+/* ----------------------------| Large arrays |----------------------------------------------------- */
+#ifdef TB_ARRAY_MMAP
+
+/*
+ * without mremap mappings reserve address space for this many times their size, so they
+ * can grow in place by committing more pages
+ */
+#ifdef MREMAP_MAYMOVE
+#define TB_ARRAY_MMAP_RESERVE   1
+#else
+#define TB_ARRAY_MMAP_RESERVE   16
+#endif
+
+/* mappings start with the size of the reserved address space (two elements to keep the alignment) */
+#define TB_ARRAY_MMAP_HDR_SIZE  (2 * sizeof(size_t))
+
+static size_t tb_array_page_round(size_t size)
+{
+    static size_t page_size = 0;
+    if (!page_size) page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+    return (size + page_size - 1) & ~(page_size - 1);
+}
+
+/* whether a block is mapped only depends on its size, which the allocator always gets */
+static int tb_array_mapped(size_t size)
+{
+    return size >= TB_ARRAY_MMAP_THRESHOLD;
+}
+
+static void* tb_array_map(size_t size)
+{
+    size_t committed = tb_array_page_round(size + TB_ARRAY_MMAP_HDR_SIZE);
+    size_t reserved = committed * TB_ARRAY_MMAP_RESERVE;
+
+    int prot = (reserved == committed) ? PROT_READ | PROT_WRITE : PROT_NONE;
+    size_t* base = mmap(NULL, reserved, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    /* the address space might be too small for the reservation */
+    if (base == MAP_FAILED && reserved != committed)
+    {
+        reserved = committed;
+        prot = PROT_READ | PROT_WRITE;
+        base = mmap(NULL, reserved, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (base == MAP_FAILED) return NULL;
+
+    if (prot == PROT_NONE && mprotect(base, committed, PROT_READ | PROT_WRITE) != 0)
+    {
+        munmap(base, reserved);
+        return NULL;
+    }
+
+    base[0] = reserved;
+    return (char*)base + TB_ARRAY_MMAP_HDR_SIZE;
+}
+
+static void* tb_array_mmap_malloc(size_t size)
+{
+    return tb_array_mapped(size) ? tb_array_map(size) : malloc(size);
+}
+
+static void tb_array_mmap_free(void* block, size_t size)
+{
+    if (!tb_array_mapped(size))
+    {
+        free(block);
+        return;
+    }
+
+    size_t* base = (size_t*)(void*)((char*)block - TB_ARRAY_MMAP_HDR_SIZE);
+    munmap(base, base[0]);
+}
+
+/* resizes a mapping without copying, returns NULL if that is not possible */
+static void* tb_array_remap(void* block, size_t old_size, size_t new_size)
+{
+    size_t* base = (size_t*)(void*)((char*)block - TB_ARRAY_MMAP_HDR_SIZE);
+    size_t old_committed = tb_array_page_round(old_size + TB_ARRAY_MMAP_HDR_SIZE);
+    size_t new_committed = tb_array_page_round(new_size + TB_ARRAY_MMAP_HDR_SIZE);
+
+    if (new_committed == old_committed) return block;
+
+#ifdef MREMAP_MAYMOVE
+    /* moves the pages instead of copying them */
+    base = mremap(base, old_committed, new_committed, MREMAP_MAYMOVE);
+    if (base == MAP_FAILED) return NULL;
+
+    base[0] = new_committed;
+#else
+    if (new_committed > base[0]) return NULL;
+
+    char* start = (char*)base + ((new_committed < old_committed) ? new_committed : old_committed);
+    size_t len = (new_committed < old_committed) ? old_committed - new_committed : new_committed - old_committed;
+
+    /* released pages are mapped again to give them back to the system */
+    if (new_committed < old_committed)  mmap(start, len, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+    else if (mprotect(start, len, PROT_READ | PROT_WRITE) != 0) return NULL;
+#endif
+
+    return (char*)base + TB_ARRAY_MMAP_HDR_SIZE;
+}
+
+static void* tb_array_mmap_realloc(void* block, size_t old_size, size_t new_size)
+{
+    if (!block) return tb_array_mmap_malloc(new_size);
+
+    if (!tb_array_mapped(old_size) && !tb_array_mapped(new_size)) return realloc(block, new_size);
+
+    if (tb_array_mapped(old_size) && tb_array_mapped(new_size))
+    {
+        void* remapped = tb_array_remap(block, old_size, new_size);
+        if (remapped) return remapped;
+    }
+
+    /* moving between heap and mapping (or a mapping that could not be resized) needs a copy */
+    void* new_block = tb_array_mmap_malloc(new_size);
+    if (!new_block) return NULL;
+
+    memcpy(new_block, block, (old_size < new_size) ? old_size : new_size);
+    tb_array_mmap_free(block, old_size);
+
+    return new_block;
+}
+#endif
+
+tb_allocator* tb_array_mmap_allocator(void)
+{
+#ifdef TB_ARRAY_MMAP
+    static tb_allocator allocator = { tb_array_mmap_malloc, tb_array_mmap_realloc, tb_array_mmap_free };
+    return &allocator;
+#else
+    return NULL;
+#endif
+}
+
+/* ----------------------------| File arrays |------------------------------------------------------ */
+#ifdef TB_ARRAY_FILE
+
+#define TB_ARRAY_FILE_MAGIC "TBARRAY1"
+
+/*
+ * A file array is the mapping of the whole file: this header followed by the extended header
+ * and the elements. The allocator callbacks only get the block behind this header, so the file
+ * descriptor is kept in it (it is rewritten on every open, like the allocator pointer).
+ * 32 bytes keep the elements at offset 64, so they start on a cache line.
+ */
+typedef struct
+{
+    char magic[8];
+    uint64_t elem_size;
+    int64_t fd;
+    uint64_t reserved;
+} tb_array_file_hdr;
+
+static tb_array_file_hdr* tb_array_file_header(void* block)
+{
+    return (tb_array_file_hdr*)(void*)((char*)block - sizeof(tb_array_file_hdr));
+}
+
+static void* tb_array_file_remap(tb_array_file_hdr* hdr, int fd, size_t old_size, size_t new_size)
+{
+#ifdef MREMAP_MAYMOVE
+    (void)fd;
+    void* base = mremap(hdr, old_size, new_size, MREMAP_MAYMOVE);
+    return (base == MAP_FAILED) ? NULL : base;
+#else
+    void* base = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) return NULL;
+
+    munmap(hdr, old_size);
+    return base;
+#endif
+}
+
+/* the file always has the size of the array block, it grows before and shrinks after remapping */
+static void* tb_array_file_realloc(void* block, size_t old_size, size_t new_size)
+{
+    tb_array_file_hdr* hdr = tb_array_file_header(block);
+    int fd = (int)hdr->fd;
+
+    size_t old_file = old_size + sizeof(tb_array_file_hdr);
+    size_t new_file = new_size + sizeof(tb_array_file_hdr);
+
+    if (new_file > old_file && ftruncate(fd, (off_t)new_file) != 0) return NULL;
+
+    char* base = tb_array_file_remap(hdr, fd, old_file, new_file);
+    if (!base)
+    {
+        if (new_file > old_file && ftruncate(fd, (off_t)old_file) != 0) { /* the file is only longer than needed */ }
+        return NULL;
+    }
+
+    if (new_file < old_file && ftruncate(fd, (off_t)new_file) != 0) { /* the file is only longer than needed */ }
+
+    return base + sizeof(tb_array_file_hdr);
+}
+
+/* freeing a file array only unmaps it and closes the file, the content stays in the file */
+static void tb_array_file_free(void* block, size_t size)
+{
+    tb_array_file_hdr* hdr = tb_array_file_header(block);
+    int fd = (int)hdr->fd;
+
+    munmap(hdr, size + sizeof(tb_array_file_hdr));
+    close(fd);
+}
+
+static tb_allocator tb_array_file_allocator = { NULL, tb_array_file_realloc, tb_array_file_free };
+
+void* tb_array__file_open(const char* path, size_t elem_size)
+{
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) goto fail;
+
+    size_t min_size = sizeof(tb_array_file_hdr) + tb_array__block_size(0, elem_size, 0);
+    size_t size = (size_t)st.st_size;
+
+    /* a new (empty) file becomes an empty array */
+    int created = size == 0;
+    if (created)
+    {
+        size = min_size;
+        if (ftruncate(fd, (off_t)size) != 0) goto fail;
+    }
+
+    if (size < min_size) goto fail;
+
+    tb_array_file_hdr* hdr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (hdr == MAP_FAILED) goto fail;
+
+    TB_ARRAY_HDR_ELEM* ext = (TB_ARRAY_HDR_ELEM*)(void*)(hdr + 1);
+    if (created)
+    {
+        memcpy(hdr->magic, TB_ARRAY_FILE_MAGIC, sizeof(hdr->magic));
+        hdr->elem_size = elem_size;
+        hdr->reserved = 0;
+
+        ext[1] = 0;
+        ext[2] = 0 | TB_ARRAY_EXT_FLAG;
+        ext[3] = 0;
+    }
+
+    /*
+     * the file has to be an array of the same element size that fits into the file, it can be
+     * longer than the array if a resize failed or was interrupted after growing the file
+     */
+    size_t cap = ext[2] & ~TB_ARRAY_EXT_FLAG;
+    if (memcmp(hdr->magic, TB_ARRAY_FILE_MAGIC, sizeof(hdr->magic)) != 0
+        || hdr->elem_size != elem_size
+        || ext[1] != 0
+        || !(ext[2] & TB_ARRAY_EXT_FLAG)
+        || ext[3] > cap
+        || cap > (size - min_size) / elem_size)
+    {
+        munmap(hdr, size);
+        goto fail;
+    }
+
+    /* the file is cut back to the array, so the mapping has the size of the block again */
+    size_t required = sizeof(tb_array_file_hdr) + tb_array__block_size(cap, elem_size, 0);
+    if (size > required)
+    {
+        munmap(hdr, size);
+        if (ftruncate(fd, (off_t)required) != 0) goto fail;
+
+        size = required;
+        hdr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (hdr == MAP_FAILED) goto fail;
+
+        ext = (TB_ARRAY_HDR_ELEM*)(void*)(hdr + 1);
+    }
+
+    hdr->fd = fd;
+    *(tb_allocator**)(void*)ext = &tb_array_file_allocator;
+
+    return ext + 4;
+
+fail:
+    close(fd);
+    return NULL;
+}
+
+int tb_array__file_flush(void* buf, size_t elem_size)
+{
+    if (!buf || tb_array_allocator(buf) != &tb_array_file_allocator) return -1;
+
+    TB_ARRAY_HDR_ELEM* ext = tb_array__hdr(buf) - 2;
+    size_t size = sizeof(tb_array_file_hdr) + tb_array__block_size(tb_array__cap(buf), elem_size, 0);
+
+    return msync(tb_array_file_header(ext), size, MS_SYNC);
+}
+
+#else
+
+void* tb_array__file_open(const char* path, size_t elem_size)
+{
+    (void)path;
+    (void)elem_size;
+    return NULL;
+}
+
+int tb_array__file_flush(void* buf, size_t elem_size)
+{
+    (void)buf;
+    (void)elem_size;
+    return -1;
+}
+
+#endif
@@ -3,20 +3,81 @@
 
 #include <stdlib.h>
 
+#include "tb_mem.h"
+
 #define TB_ARRAY_HDR_ELEM	size_t
 #define TB_ARRAY_HDR_SIZE	2 * sizeof(TB_ARRAY_HDR_ELEM)
 
+/*
+ * Arrays created with tb_array_create use the given allocator for all growth and free operations.
+ * The allocator is stored in an extended header in front of the regular one (two more elements,
+ * so the alignment of the data does not change) and marked by the highest bit of the capacity.
+ * The second element of the extended header holds the alignment of aligned arrays.
+ * Arrays without an allocator keep the plain header and use realloc/free.
+ */
+#define TB_ARRAY_EXT_SIZE	2 * sizeof(TB_ARRAY_HDR_ELEM)
+#define TB_ARRAY_EXT_FLAG	((size_t)1 << (sizeof(size_t) * 8 - 1))
+
 #define tb_array__hdr(b) ((size_t*)(void*)(b) - 2)
-#define tb_array__cap(b) tb_array__hdr(b)[0]
+#define tb_array__cap(b) (tb_array__hdr(b)[0] & ~TB_ARRAY_EXT_FLAG)
 #define tb_array__len(b) tb_array__hdr(b)[1]
+#define tb_array__ext(b) (tb_array__hdr(b)[0] & TB_ARRAY_EXT_FLAG)
 
 #define tb_array_len(b) ((b) ? tb_array__len(b) : 0)
 #define tb_array_cap(b) ((b) ? tb_array__cap(b) : 0)
 
+#define tb_array_allocator(b) (((b) && tb_array__ext(b)) ? *(tb_allocator**)(void*)(tb_array__hdr(b) - 2) : NULL)
+
 #define tb_array_resize(b, n)   (*((void**)&(b)) = tb_array__resize((b), (n), sizeof(*(b))))
 #define tb_array_reserve(b, n)  (*((void**)&(b)) = tb_array__reserve((b), (n), sizeof(*(b))))
 #define tb_array_grow(b, n)     (*((void**)&(b)) = tb_array__grow((b), (n), sizeof(*(b))))
 
+/*
+ * creates an empty array with room for n elements whose memory is managed by allocator
+ * callbacks of the allocator that are NULL fall back to malloc/realloc/free
+ * once the array is freed (or an empty one is packed) it is NULL and no longer uses the allocator
+ */
+#define tb_array_create(b, n, a) (*((void**)&(b)) = tb_array__create((n), sizeof(*(b)), (a)))
+
+/*
+ * creates an empty array whose data is aligned to align bytes (a power of two, e.g. 32 or 64
+ * for SIMD loads or a cache line, or the page size), the alignment is kept on growth
+ * the headers are placed in front of the data, allocator may be NULL for malloc/realloc/free
+ * once the array is freed it is NULL and no longer aligned
+ */
+#define tb_array_create_aligned(b, n, align, a) (*((void**)&(b)) = tb_array__create_aligned((n), sizeof(*(b)), (align), (a)))
+
+/*
+ * allocator for large arrays (use with tb_array_create)
+ * blocks of at least TB_ARRAY_MMAP_THRESHOLD bytes are anonymous memory mappings that grow
+ * with mremap, which moves pages instead of copying them (on Linux mremap needs _GNU_SOURCE).
+ * without mremap mappings reserve address space up front and grow in place by committing
+ * pages, they are only copied once the reservation is exceeded. smaller blocks use malloc/realloc.
+ * returns NULL if memory mappings are not available, which makes tb_array_create fall back
+ * to a regular array.
+ */
+#define TB_ARRAY_MMAP_THRESHOLD (1 << 20)
+
+tb_allocator* tb_array_mmap_allocator(void);
+
+/*
+ * arrays whose storage is a memory mapped file, for arrays of plain data that should persist
+ * tb_array_file_open maps the array in the file at path (created if it does not exist) and
+ * returns NULL if the file can not be mapped or is not an array of elements of the same size.
+ * the array grows and shrinks the file (ftruncate and remap) and works with all tb_array
+ * operations, freeing it (tb_array_file_close) unmaps and closes the file and keeps the content.
+ * reopening the file maps it again without reading or converting the elements, so pointers into
+ * the array are not stored and the elements have to be the same type on every open.
+ * tb_array_file_flush writes the mapped pages to disk (msync), returns 0 on success.
+ * like freeing, packing an empty file array or resizing it to 0 closes the file and sets it to
+ * NULL, later pushes then create a regular array that is not stored. use tb_array_clear instead.
+ * needs memory mapped files and ftruncate (on Linux _GNU_SOURCE or _POSIX_C_SOURCE >= 200112L),
+ * without them tb_array_file_open always returns NULL.
+ */
+#define tb_array_file_open(b, path) (*((void**)&(b)) = tb_array__file_open((path), sizeof(*(b))))
+#define tb_array_file_flush(b)      (tb_array__file_flush((b), sizeof(*(b))))
+#define tb_array_file_close(b)      (tb_array_free(b))
+
 #define tb_array_push(b, v) (tb_array_grow((b), 1), (b)[tb_array__len(b)++] = (v))
 #define tb_array_free(b)    (tb_array_resize(b, 0))
 
@@ -26,8 +87,54 @@
 #define tb_array_last(b)    ((b) + tb_array_len(b))
 #define tb_array_sizeof(b)  (tb_array_len(b) * sizeof(*(b)))
 
+/*
+ * bulk operations, each does at most one reallocation and one memcpy/memmove
+ * tb_array_append_n:   appends n elements copied from src
+ * tb_array_insert_n:   inserts n elements copied from src before index i (i <= len)
+ * tb_array_add_uninit: appends n uninitialized elements and returns a pointer to the first
+ * tb_array_erase_n:    removes n elements starting at index i (i + n <= len)
+ * tb_array_swap_remove: removes the element at index i by moving the last element into its place
+ * src may point into the array itself, if src is NULL the new elements are left uninitialized
+ * on allocation failure the array becomes NULL (like tb_array_grow) and add_uninit returns NULL
+ */
+#define tb_array_append_n(b, src, n)    (*((void**)&(b)) = tb_array__insert((b), tb_array_len(b), (src), (n), sizeof(*(b))))
+#define tb_array_insert_n(b, i, src, n) (*((void**)&(b)) = tb_array__insert((b), (i), (src), (n), sizeof(*(b))))
+#define tb_array_add_uninit(b, n)       (tb_array_append_n((b), NULL, (n)), (b) ? tb_array_last(b) - (n) : NULL)
+#define tb_array_erase_n(b, i, n)       (tb_array__erase((b), (i), (n), sizeof(*(b))))
+#define tb_array_swap_remove(b, i)      ((b)[i] = (b)[--tb_array__len(b)])
+
+/*
+ * small arrays keep up to n elements in inline storage and only allocate once they outgrow it
+ * declare the type with tb_array_small, e.g. typedef tb_array_small(int, 8) int_vec;
+ * a zero initialized small array is empty and uses its inline storage, it holds no pointer
+ * to itself and can be moved with a plain assignment (copies share the heap storage once spilled)
+ * elements are accessed through tb_array_small_data, which changes when the array spills
+ * tb_array_small_grow/push return 0 on allocation failure and leave the array unchanged
+ */
+#define tb_array_small(type, n) struct { type* heap; size_t len; size_t cap; type local[n]; }
+
+#define tb_array_small__local_cap(s)    (sizeof((s).local) / sizeof(*(s).local))
+
+#define tb_array_small_data(s)  ((s).heap ? (s).heap : (s).local)
+#define tb_array_small_len(s)   ((s).len)
+#define tb_array_small_cap(s)   ((s).heap ? (s).cap : tb_array_small__local_cap(s))
+
+#define tb_array_small_grow(s, n)   (((s).len + (n) <= tb_array_small_cap(s)) ? 1 : \
+                                    tb_array__small_grow((void**)&(s).heap, &(s).cap, (s).local, tb_array_small__local_cap(s), (s).len, (n), sizeof(*(s).local)))
+#define tb_array_small_push(s, v)   (tb_array_small_grow((s), 1) ? (tb_array_small_data(s)[(s).len++] = (v), 1) : 0)
+
+#define tb_array_small_clear(s) ((s).len = 0)
+#define tb_array_small_free(s)  (free((s).heap), (s).heap = NULL, (s).len = 0, (s).cap = 0)
+
 void* tb_array__resize(void* buf, size_t new_cap, size_t elem_size);
 void* tb_array__reserve(void* buf, size_t reserve, size_t elem_size);
 void* tb_array__grow(void* buf, size_t increment, size_t elem_size);
+void* tb_array__create(size_t cap, size_t elem_size, tb_allocator* allocator);
+void* tb_array__create_aligned(size_t cap, size_t elem_size, size_t align, tb_allocator* allocator);
+void* tb_array__insert(void* buf, size_t index, const void* src, size_t n, size_t elem_size);
+void  tb_array__erase(void* buf, size_t index, size_t n, size_t elem_size);
+void* tb_array__file_open(const char* path, size_t elem_size);
+int   tb_array__file_flush(void* buf, size_t elem_size);
+int   tb_array__small_grow(void** heap, size_t* cap, const void* local, size_t local_cap, size_t len, size_t increment, size_t elem_size);
 
 #endif /* !TB_ARRAY_H */
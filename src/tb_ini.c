@@ -2,21 +2,68 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <errno.h>
+#include <locale.h>
+#include <math.h>
+#include <float.h>
+#include <limits.h>
+
+/*
+ * All parsing functions take a cursor and an end pointer. If end is NULL the
+ * input is treated as zero terminated, else no byte at or after end is read.
+ */
+#define TB_INI_EOF(cursor, end) (((end) && (cursor) >= (end)) || *(cursor) == '\0')
+
+/* size of the stack buffer numbers are copied to if they have to be converted by strtod */
+#define TB_INI_NUM_BUF_SIZE     64
+
+static const char* tb_ini_skip_whitespace(const char* cursor, const char* end)
+{
+    while (cursor && !TB_INI_EOF(cursor, end) && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r')) cursor++;
+    return cursor;
+}
+
+/* converts to float, finite values beyond the range of float are TB_INI_OUT_OF_RANGE instead of inf */
+static tb_ini_error tb_ini_element_to_float_checked(const tb_ini_element* element, float* value)
+{
+    double d;
+    tb_ini_error error = tb_ini_element_to_double(element, &d);
+    if (error != TB_INI_OK) return error;
+
+    if (!isinf(d) && (d > FLT_MAX || d < -FLT_MAX)) return TB_INI_OUT_OF_RANGE;
+
+    *value = (float)d;
+    return TB_INI_OK;
+}
 
-static char* tb_ini_skip_whitespace(char* cursor)
+/* removes trailing spaces ignoring current cursor pos (never moves before start) */
+static const char* tb_ini_clip_tail(const char* start, const char* cursor)
 {
-    while (cursor && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r')) cursor++;
+    while (cursor && cursor > start && (*(cursor-1) == ' ' || *(cursor-1) == '\t')) cursor--;
     return cursor;
 }
 
-/* removes trailing spaces ignoring current cursor pos */
-static char* tb_ini_clip_tail(char* cursor)
+/* returns a pointer to the next line break or the end of the input */
+static const char* tb_ini_skip_line(const char* cursor, const char* end)
 {
-    while (cursor && (*(cursor-1) == ' ' || *(cursor-1) == '\t')) cursor--;
+    while (!TB_INI_EOF(cursor, end) && *cursor != '\n') cursor++;
     return cursor;
 }
 
-static size_t tb_ini_strncpy(char* dst, char* src, size_t len, size_t max_len)
+/* checks if the input at cursor starts with the first len bytes of str */
+static int tb_ini_match(const char* cursor, const char* end, const char* str, size_t len)
+{
+    if (end) return (size_t)(end - cursor) >= len && memcmp(cursor, str, len) == 0;
+    return strncmp(cursor, str, len) == 0;
+}
+
+/* checks if the name of a property ends at cursor */
+static int tb_ini_name_end(const char* cursor, const char* end)
+{
+    return !TB_INI_EOF(cursor, end) && (*cursor == ' ' || *cursor == '\t' || *cursor == '=');
+}
+
+static size_t tb_ini_strncpy(char* dst, const char* src, size_t len, size_t max_len)
 {
     if (len >= max_len) len = max_len - 1;
     strncpy(dst, src, len);
@@ -26,7 +73,7 @@ static size_t tb_ini_strncpy(char* dst, char* src, size_t len, size_t max_len)
 }
 
 /* create a value element with a length of (end-start) pointing to start */
-static char* tb_ini_make_element(tb_ini_element* element, char* start, char* end)
+static const char* tb_ini_make_element(tb_ini_element* element, const char* start, const char* end)
 {
     element->start = start;
     element->len = end - start;
@@ -35,7 +82,7 @@ static char* tb_ini_make_element(tb_ini_element* element, char* start, char* end
 }
 
 /* create an error element pointing to pos */
-static char* tb_ini_make_error(tb_ini_element* element, tb_ini_error error, char* pos)
+static const char* tb_ini_make_error(tb_ini_element* element, tb_ini_error error, const char* pos)
 {
     element->start = pos;
     element->len = 0;
@@ -43,15 +90,17 @@ static char* tb_ini_make_error(tb_ini_element* element, tb_ini_error error, char
     return pos;
 }
 
+static const char* tb_ini__property_next(const char* ini, const char* end, tb_ini_element* element);
+
 /* create a section element pointing to pos where len is the number of properties in that section */
-static char* tb_ini_make_section(tb_ini_element* element, char* start)
+static const char* tb_ini_make_section(tb_ini_element* element, const char* start, const char* end)
 {
     element->start = start;
     element->len = 0;
     element->error = TB_INI_OK;
 
     tb_ini_element prop;
-    while ((start = tb_ini_property_next(start, &prop)) != NULL)
+    while ((start = tb_ini__property_next(start, end, &prop)) != NULL)
     {
         if (prop.error != TB_INI_OK) return tb_ini_make_error(element, TB_INI_BAD_VALUE, prop.start);
         element->len++;
@@ -59,81 +108,80 @@ static char* tb_ini_make_section(tb_ini_element* element, char* start)
     return element->start;
 }
 
-static char* tb_ini_read_element(char* ini, tb_ini_element* element)
+static const char* tb_ini_read_element(const char* ini, const char* end, tb_ini_element* element)
 {
     if (!ini) return tb_ini_make_error(element, TB_INI_BAD_PROPERTY, ini);
 
     /* read key */
-    char* start = ini;
+    const char* start = ini;
 
-    while (*ini != '\0' && *ini != '\n' && *ini != '\r' && *ini != '=') ini++;
+    while (!TB_INI_EOF(ini, end) && *ini != '\n' && *ini != '\r' && *ini != '=') ini++;
 
     element->name = start;
-    element->name_len = tb_ini_clip_tail(ini) - start;
+    element->name_len = tb_ini_clip_tail(start, ini) - start;
 
     /* check for '=' between key and value and skip it with surrounding spaces */
-    ini = tb_ini_skip_whitespace(ini);
-    if (*ini != '=') return tb_ini_make_error(element, TB_INI_BAD_PROPERTY, ini);
-    ini = tb_ini_skip_whitespace(++ini);
+    ini = tb_ini_skip_whitespace(ini, end);
+    if (TB_INI_EOF(ini, end) || *ini != '=') return tb_ini_make_error(element, TB_INI_BAD_PROPERTY, ini);
+    ini = tb_ini_skip_whitespace(++ini, end);
 
     /* read the value*/
     start = ini;
 
     /* read grouped value */
-    if (*ini == '{')
+    if (!TB_INI_EOF(ini, end) && *ini == '{')
     {
-        while (*ini != '\0' && *ini != '}') ini++;
-        
+        while (!TB_INI_EOF(ini, end) && *ini != '}') ini++;
+
         /* skip closing braces */
-        if (*ini++ == '\0') return tb_ini_make_error(element, TB_INI_BAD_VALUE, start);
+        if (TB_INI_EOF(ini, end)) return tb_ini_make_error(element, TB_INI_BAD_VALUE, start);
+        const char* value_end = ++ini;
 
         /* check if line is empty after grouped value */
-        char* check = ini;
-        while (*ini != '\0' && *ini != '\n' && *ini != '\r')
+        while (!TB_INI_EOF(ini, end) && *ini != '\n' && *ini != '\r')
         {
-            if (*check != ' ' && *check != '\t') return tb_ini_make_error(element, TB_INI_BAD_VALUE, check);
-            check++;
+            if (*ini != ' ' && *ini != '\t') return tb_ini_make_error(element, TB_INI_BAD_VALUE, ini);
+            ini++;
         }
 
-        return tb_ini_make_element(element, start, ini);
+        return tb_ini_make_element(element, start, value_end);
     }
 
     /* read standard value */
-    while (*ini != '\0' && *ini != '\n' && *ini != '\r') ini++;
+    while (!TB_INI_EOF(ini, end) && *ini != '\n' && *ini != '\r') ini++;
 
-    return tb_ini_make_element(element, start, tb_ini_clip_tail(ini));
+    return tb_ini_make_element(element, start, tb_ini_clip_tail(start, ini));
 }
 
-static char* tb_ini_read_section(char* ini, size_t len, tb_ini_element* element)
+static const char* tb_ini_read_section(const char* ini, const char* end, size_t len, tb_ini_element* element)
 {
     /* check if its the complete name */
-    char* cursor = tb_ini_skip_whitespace(ini + len);
-    if (cursor && *cursor == ']')
+    const char* cursor = tb_ini_skip_whitespace(ini + len, end);
+    if (!TB_INI_EOF(cursor, end) && *cursor == ']')
     {
         element->name = ini;
         element->name_len = len;
-        return tb_ini_skip_whitespace(++cursor);
+        return tb_ini_skip_whitespace(++cursor, end);
     }
 
     return cursor;
 }
 
-static char* tb_ini_read_group(char* ini, size_t len, tb_ini_element* element)
+static const char* tb_ini_read_group(const char* ini, const char* end, size_t len, tb_ini_element* element)
 {
     ini += len; /* skip group name */
-    if (*ini++ == '.')
-    {
-        /* get section name */
-        char* start = ini;
-        while (*ini != ']' && *ini != '\0') ini++;
+    if (TB_INI_EOF(ini, end)) return NULL;
+    if (*ini++ != '.') return ini;
 
-        if (*ini == '\0') return NULL;
-        return tb_ini_read_section(start, ini - start, element);
-    }
-    return ini;
+    /* get section name */
+    const char* start = ini;
+    while (!TB_INI_EOF(ini, end) && *ini != ']') ini++;
+
+    if (TB_INI_EOF(ini, end)) return NULL;
+    return tb_ini_read_section(start, end, ini - start, element);
 }
 
-static char* tb_ini_find_section(char* ini, const char* name, int group, tb_ini_element* element)
+static const char* tb_ini_find_section(const char* ini, const char* end, const char* name, int group, tb_ini_element* element)
 {
     if (!name) return ini;
 
@@ -142,118 +190,116 @@ static char* tb_ini_find_section(char* ini, const char* name, int group, tb_ini_
     element->name_len = 0;
 
     size_t name_len = strlen(name);
-    while (*ini != '\0')
+    while (!TB_INI_EOF(ini, end))
     {
         /* start of a new section found, check if name matches */
-        if (*ini == '[' && strncmp(++ini, name, name_len) == 0)
-        {
-            /* read section or group depending on the flag set */
-            if (group)  ini = tb_ini_read_group(ini, name_len, element);
-            else        ini = tb_ini_read_section(ini, name_len, element);
+        if (*ini++ != '[' || !tb_ini_match(ini, end, name, name_len)) continue;
 
-            /* if ini == NULL: failed to read section/group -> return NULL */
-            if (!ini) return NULL;
+        /* read section or group depending on the flag set */
+        if (group)  ini = tb_ini_read_group(ini, end, name_len, element);
+        else        ini = tb_ini_read_section(ini, end, name_len, element);
 
-            /* if element->name_len > 0: successfully read section/group -> return cursor after it */
-            if (element->name_len > 0) return ini;
-        }
-        ini++;
+        /* if ini == NULL: failed to read section/group -> return NULL */
+        if (!ini) return NULL;
+
+        /* if element->name_len > 0: successfully read section/group -> return cursor after it */
+        if (element->name_len > 0) return ini;
     }
 
     return NULL;
 }
 
-/* ----------------------------| Public API |------------------------------------------------------- */
-char* tb_ini_query(char* ini, const char* section, const char* prop, tb_ini_element* element)
-{
-    char* section_start = tb_ini_find_section(ini, section, 0, element);
-
-    if (!section_start) return tb_ini_make_error(element, TB_INI_BAD_SECTION, NULL);
-    if (!prop)          return tb_ini_make_section(element, section_start);
-
-    return tb_ini_query_section(section_start, prop, element);
-}
-
-char* tb_ini_query_section(char* section, const char* prop, tb_ini_element* element)
+static const char* tb_ini__query_section(const char* section, const char* end, const char* prop, tb_ini_element* element)
 {
     size_t query_len = strlen(prop);
-    section = tb_ini_skip_whitespace(section);
+    section = tb_ini_skip_whitespace(section, end);
 
-    if (query_len == 0) return tb_ini_read_element(section, element);
+    if (query_len == 0) return tb_ini_read_element(section, end, element);
 
-    while (section && *section != '\0' && *section != '[')
+    while (section && !TB_INI_EOF(section, end) && *section != '[')
     {
-        /* compare key */
-        if (strncmp(section, prop, query_len) == 0) return tb_ini_read_element(section, element);
+        /* compare key, it has to be the full name (followed by spaces or '=') */
+        if (tb_ini_match(section, end, prop, query_len) && tb_ini_name_end(section + query_len, end))
+            return tb_ini_read_element(section, end, element);
 
         /* skip to next property */
-        section = strpbrk(section, "\n\0");
-        section = tb_ini_skip_whitespace(section);
+        section = tb_ini_skip_line(section, end);
+        section = tb_ini_skip_whitespace(section, end);
     }
 
     return tb_ini_make_error(element, TB_INI_BAD_PROPERTY, NULL);
 }
 
-char* tb_ini_group_next(char* ini, const char* group, tb_ini_element* element)
+static const char* tb_ini__query(const char* ini, const char* end, const char* section, const char* prop, tb_ini_element* element)
 {
-    if (!group) return NULL;
-    char* start = tb_ini_find_section(ini, group, 1, element);
+    const char* section_start = tb_ini_find_section(ini, end, section, 0, element);
 
-    if (!start) return tb_ini_make_error(element, TB_INI_BAD_SECTION, NULL);
-    return tb_ini_make_section(element, start);
+    if (!section_start) return tb_ini_make_error(element, TB_INI_BAD_SECTION, NULL);
+    if (!prop)          return tb_ini_make_section(element, section_start, end);
+
+    return tb_ini__query_section(section_start, end, prop, element);
 }
 
-char* tb_ini_property_next(char* ini, tb_ini_element* element)
+static const char* tb_ini__group_next(const char* ini, const char* end, const char* group, tb_ini_element* element)
 {
-    ini = tb_ini_skip_whitespace(ini);
-    return (ini && *ini != '\0' && *ini != '[') ? tb_ini_read_element(ini, element) : NULL;
-}
+    if (!group) return NULL;
+    const char* start = tb_ini_find_section(ini, end, group, 1, element);
 
-int tb_ini_element_to_bool(tb_ini_element* element)     { return (strncmp(element->start, "true", element->len) == 0) ? 1 : 0; }
-int tb_ini_element_to_int(tb_ini_element* element)      { return atoi(element->start); }
-float tb_ini_element_to_float(tb_ini_element* element)  { return (float)atof(element->start); }
+    if (!start) return tb_ini_make_error(element, TB_INI_BAD_SECTION, NULL);
+    return tb_ini_make_section(element, start, end);
+}
 
-size_t tb_ini_element_to_string(tb_ini_element* element, char* dst, size_t dst_len)
+static const char* tb_ini__property_next(const char* ini, const char* end, tb_ini_element* element)
 {
-    return tb_ini_strncpy(dst, element->start, element->len, dst_len);
+    ini = tb_ini_skip_whitespace(ini, end);
+    return (ini && !TB_INI_EOF(ini, end) && *ini != '[') ? tb_ini_read_element(ini, end, element) : NULL;
 }
 
-size_t tb_ini_name(const tb_ini_element* element, char* dst, size_t dst_len)
+static int tb_ini__bool(const char* ini, const char* end, const char* section, const char* prop, int def)
 {
-    if (element->error == TB_INI_OK) return tb_ini_strncpy(dst, element->name, element->name_len, dst_len);
+    tb_ini_element element;
+    tb_ini__query(ini, end, section, prop, &element);
 
-    dst[0] = '\0';
-    return 0;
+    return (element.error == TB_INI_OK) ? tb_ini_element_to_bool(&element) : def;
 }
 
-int tb_ini_bool(char* ini, const char* section, const char* prop, int def)
+static int64_t tb_ini__int64(const char* ini, const char* end, const char* section, const char* prop, int64_t def)
 {
     tb_ini_element element;
-    tb_ini_query(ini, section, prop, &element);
+    tb_ini__query(ini, end, section, prop, &element);
 
-    return (element.error == TB_INI_OK) ? tb_ini_element_to_bool(&element) : def;
+    int64_t value;
+    return (element.error == TB_INI_OK && tb_ini_element_to_int64(&element, &value) == TB_INI_OK) ? value : def;
 }
 
-int tb_ini_int(char* ini, const char* section, const char* prop, int def)
+static int tb_ini__int(const char* ini, const char* end, const char* section, const char* prop, int def)
+{
+    int64_t value = tb_ini__int64(ini, end, section, prop, def);
+    return (value >= INT_MIN && value <= INT_MAX) ? (int)value : def;
+}
+
+static double tb_ini__double(const char* ini, const char* end, const char* section, const char* prop, double def)
 {
     tb_ini_element element;
-    tb_ini_query(ini, section, prop, &element);
+    tb_ini__query(ini, end, section, prop, &element);
 
-    return (element.error == TB_INI_OK) ? tb_ini_element_to_int(&element) : def;
+    double value;
+    return (element.error == TB_INI_OK && tb_ini_element_to_double(&element, &value) == TB_INI_OK) ? value : def;
 }
 
-float tb_ini_float(char* ini, const char* section, const char* prop, float def)
+static float tb_ini__float(const char* ini, const char* end, const char* section, const char* prop, float def)
 {
     tb_ini_element element;
-    tb_ini_query(ini, section, prop, &element);
+    tb_ini__query(ini, end, section, prop, &element);
 
-    return (element.error == TB_INI_OK) ? tb_ini_element_to_float(&element) : def;
+    float value;
+    return (element.error == TB_INI_OK && tb_ini_element_to_float_checked(&element, &value) == TB_INI_OK) ? value : def;
 }
 
-size_t tb_ini_string(char* ini, const char* section, const char* prop, char* dst, size_t dst_len)
+static size_t tb_ini__string(const char* ini, const char* end, const char* section, const char* prop, char* dst, size_t dst_len)
 {
     tb_ini_element element;
-    tb_ini_query(ini, section, prop, &element);
+    tb_ini__query(ini, end, section, prop, &element);
 
     if (element.error == TB_INI_OK) return tb_ini_element_to_string(&element, dst, dst_len);
 
@@ -261,27 +307,27 @@ size_t tb_ini_string(char* ini, const char* section, const char* prop, char* dst
     return 0;
 }
 
-int tb_ini_parse(char* ini, const char* section, const char* prop, tb_ini_parse_func parse)
+static int tb_ini__parse(const char* ini, const char* end, const char* section, const char* prop, tb_ini_parse_func parse)
 {
     tb_ini_element element;
-    tb_ini_query(ini, section, prop, &element);
+    tb_ini__query(ini, end, section, prop, &element);
 
     return parse(element.start, element.len);
 }
 
-char* tb_ini_csv(char* ini, const char* section, const char* prop, tb_ini_element* element)
+static const char* tb_ini__csv(const char* ini, const char* end, const char* section, const char* prop, tb_ini_element* element)
 {
-    tb_ini_query(ini, section, prop, element);
+    tb_ini__query(ini, end, section, prop, element);
     if (element->error != TB_INI_OK) return element->start;
 
     /* check if element starts with a brace */
-    if (*element->start != '{') return tb_ini_make_error(element, TB_INI_BAD_VALUE, element->start);
+    if (element->len == 0 || *element->start != '{') return tb_ini_make_error(element, TB_INI_BAD_VALUE, element->start);
 
-    char* csv = ++element->start;
+    const char* csv = ++element->start;
     element->len = 0;
 
     /* count values in csv list */
-    while (*csv != '\0' && *csv != '}')
+    while (!TB_INI_EOF(csv, end) && *csv != '}')
     {
         /* TODO: check for line end without comma (except for last value) */
         element->len += (*csv == ',');
@@ -289,24 +335,1092 @@ char* tb_ini_csv(char* ini, const char* section, const char* prop, tb_ini_elemen
     }
 
     /* add last element if csv is not empty */
-    element->len += ((tb_ini_clip_tail(csv) - element->start) > 0);
+    element->len += ((tb_ini_clip_tail(element->start, csv) - element->start) > 0);
 
     return csv;
 }
 
-char* tb_ini_csv_step(char* stream, tb_ini_element* element)
+static const char* tb_ini__csv_step(const char* stream, const char* end, tb_ini_element* element)
 {
     if (!stream) return NULL;
 
-    stream = tb_ini_skip_whitespace(stream);
+    stream = tb_ini_skip_whitespace(stream, end);
     element->start = stream;
 
     /* find end of value */
-    while (*stream != '\0' && *stream != '\n' && *stream != '\r' && *stream != '}' && *stream != ',') stream++;
+    while (!TB_INI_EOF(stream, end) && *stream != '\n' && *stream != '\r' && *stream != '}' && *stream != ',') stream++;
+
+    element->len = tb_ini_clip_tail(element->start, stream) - element->start;
+
+    return (!TB_INI_EOF(stream, end) && *stream != '}') ? ++stream : NULL;
+}
+
+/* returns the end of the CSV value starting at cursor (the next comma or the closing brace) */
+static const char* tb_ini_csv_value_end(const char* cursor, const char* list_end)
+{
+    const char* comma = memchr(cursor, ',', list_end - cursor);
+    return comma ? comma : list_end;
+}
+
+static tb_ini_error tb_ini_csv_to_int(const char* start, const char* end, int* value)
+{
+    /* fast path for plain decimals with up to 9 digits, they can not overflow an int */
+    const char* cursor = start + (*start == '-' || *start == '+');
+    if (cursor < end && end - cursor <= 9)
+    {
+        int result = 0;
+        while (cursor < end && (unsigned)(*cursor - '0') < 10) result = result * 10 + (*cursor++ - '0');
+
+        if (cursor == end)
+        {
+            *value = (*start == '-') ? -result : result;
+            return TB_INI_OK;
+        }
+    }
+
+    tb_ini_element element = { NULL, 0, start, end - start, TB_INI_OK };
+    int64_t i;
+
+    tb_ini_error error = tb_ini_element_to_int64(&element, &i);
+    if (error != TB_INI_OK) return error;
+    if (i < INT_MIN || i > INT_MAX) return TB_INI_OUT_OF_RANGE;
+
+    *value = (int)i;
+    return TB_INI_OK;
+}
+
+static tb_ini_error tb_ini_csv_to_float(const char* start, const char* end, float* value)
+{
+    tb_ini_element element = { NULL, 0, start, end - start, TB_INI_OK };
+    return tb_ini_element_to_float_checked(&element, value);
+}
+
+static size_t tb_ini__csv_to_array(const char* ini, const char* end, const char* section, const char* prop, tb_ini_type type, void* dst, size_t dst_len, tb_ini_element* element)
+{
+    tb_ini__query(ini, end, section, prop, element);
+    if (element->error != TB_INI_OK) return 0;
+
+    if (element->len < 2 || *element->start != '{')
+    {
+        tb_ini_make_error(element, TB_INI_BAD_VALUE, element->start);
+        return 0;
+    }
+
+    /* the grouped value spans from the opening to the closing brace */
+    const char* cursor = element->start + 1;
+    const char* list_end = element->start + element->len - 1;
+
+    size_t count = 0;
+    cursor = tb_ini_skip_whitespace(cursor, list_end);
+    while (cursor < list_end)
+    {
+        const char* value_end = tb_ini_csv_value_end(cursor, list_end);
+        const char* value_tail = tb_ini_clip_tail(cursor, value_end);
+        while (value_tail > cursor && (value_tail[-1] == '\n' || value_tail[-1] == '\r')) value_tail = tb_ini_clip_tail(cursor, value_tail - 1);
+
+        tb_ini_error error = TB_INI_OUT_OF_RANGE;
+        if (value_tail == cursor)   error = TB_INI_BAD_VALUE;
+        else if (count < dst_len)   error = (type == TB_INI_TYPE_INT) ? tb_ini_csv_to_int(cursor, value_tail, (int*)dst + count)
+                                                                 : tb_ini_csv_to_float(cursor, value_tail, (float*)dst + count);
+
+        /* let the element point to the first bad value */
+        if (error != TB_INI_OK)
+        {
+            tb_ini_make_element(element, cursor, value_tail);
+            element->error = error;
+            return count;
+        }
+
+        count++;
+
+        /* a comma has to be followed by another value */
+        if (value_end == list_end) break;
+        cursor = tb_ini_skip_whitespace(value_end + 1, list_end);
+
+        if (cursor == list_end)
+        {
+            tb_ini_make_error(element, TB_INI_BAD_VALUE, cursor);
+            return count;
+        }
+    }
+
+    element->start++;
+    element->len = count;
+    return count;
+}
+
+/* ----------------------------| Section cursor |--------------------------------------------------- */
+/* returns the next line starting with '[' or NULL */
+static const char* tb_ini_next_header(const char* pos, const char* end)
+{
+    while ((pos = tb_ini_skip_whitespace(pos, end)) && !TB_INI_EOF(pos, end))
+    {
+        if (*pos == '[') return pos;
+        pos = tb_ini_skip_line(pos, end);
+    }
+    return NULL;
+}
+
+/* ----------------------------| Number conversion |------------------------------------------------ */
+static const double tb_ini_pow10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* returns the value of a hex digit or 0xff if c is not a digit */
+static unsigned tb_ini_digit(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return 0xff;
+}
+
+/*
+ * the slow path converts with strtod_l and a C locale that is created once, so the decimal point
+ * is always '.'. without strtod_l (on Linux it needs _GNU_SOURCE) or if the locale can not be
+ * created, the '.' is replaced with the decimal point of the current locale for strtod, which
+ * races with setlocale in other threads.
+ */
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TB_INI_STRTOD_L
+typedef _locale_t tb_ini_locale;
+#define tb_ini_locale_create()      _create_locale(LC_NUMERIC, "C")
+#define tb_ini_locale_free(l)       _free_locale(l)
+#define tb_ini_locale_load(p)       ((tb_ini_locale)_InterlockedCompareExchangePointer((void* volatile*)(p), NULL, NULL))
+#define tb_ini_locale_cas(p, l)     (_InterlockedCompareExchangePointer((void* volatile*)(p), (l), NULL) == NULL)
+#define tb_ini_strtod_l(s, e, l)    _strtod_l((s), (e), (l))
+#elif (defined(__GLIBC__) && defined(_GNU_SOURCE)) || defined(__APPLE__) || defined(__FreeBSD__)
+#if defined(__APPLE__) || defined(__FreeBSD__)
+#include <xlocale.h>
+#endif
+#define TB_INI_STRTOD_L
+typedef locale_t tb_ini_locale;
+#define tb_ini_locale_create()      newlocale(LC_NUMERIC_MASK, "C", (locale_t)0)
+#define tb_ini_locale_free(l)       freelocale(l)
+#define tb_ini_locale_load(p)       __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define tb_ini_locale_cas(p, l)     __atomic_compare_exchange_n((p), &(tb_ini_locale){ (locale_t)0 }, (l), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define tb_ini_strtod_l(s, e, l)    strtod_l((s), (e), (l))
+#else
+typedef void* tb_ini_locale;
+#define tb_ini_c_locale()           NULL
+#define tb_ini_strtod_l(s, e, l)    strtod((s), (e))
+#endif
+
+#ifdef TB_INI_STRTOD_L
+static tb_ini_locale tb_ini_c_locale(void)
+{
+    static tb_ini_locale locale;
+
+    tb_ini_locale current = tb_ini_locale_load(&locale);
+    if (current) return current;
+
+    tb_ini_locale created = tb_ini_locale_create();
+    if (!created) return created;
+
+    /* another thread may have created one first, only that one is kept */
+    if (tb_ini_locale_cas(&locale, created)) return created;
+
+    tb_ini_locale_free(created);
+    return tb_ini_locale_load(&locale);
+}
+#endif
+
+/* slow path for numbers the fast path can not round correctly */
+static tb_ini_error tb_ini_strtod(const char* start, size_t len, double* value)
+{
+    tb_ini_locale locale = tb_ini_c_locale();
+
+    /* the decimal point can be longer than one byte in the current locale */
+    const char* point = locale ? "." : localeconv()->decimal_point;
+    size_t point_len = strlen(point);
+    const char* dot = memchr(start, '.', len);
+    size_t str_len = dot ? len - 1 + point_len : len;
+
+    char buf[TB_INI_NUM_BUF_SIZE];
+    char* str = (str_len < TB_INI_NUM_BUF_SIZE) ? buf : malloc(str_len + 1);
+    if (!str) return TB_INI_UNKOWN_ERROR;
+
+    if (dot)
+    {
+        size_t before = (size_t)(dot - start);
+        memcpy(str, start, before);
+        memcpy(str + before, point, point_len);
+        memcpy(str + before + point_len, dot + 1, len - before - 1);
+    }
+    else
+    {
+        memcpy(str, start, len);
+    }
+    str[str_len] = '\0';
+
+    char* end;
+    errno = 0;
+    double result = locale ? tb_ini_strtod_l(str, &end, locale) : strtod(str, &end);
+
+    tb_ini_error error = TB_INI_OK;
+    if (end != str + str_len)                                               error = TB_INI_BAD_VALUE;
+    else if (errno == ERANGE && (result == HUGE_VAL || result == -HUGE_VAL)) error = TB_INI_OUT_OF_RANGE;
+    else                                                                    *value = result;
+
+    if (str != buf) free(str);
+    return error;
+}
+
+/* ----------------------------| Batch queries |---------------------------------------------------- */
+typedef struct
+{
+    tb_ini_batch_item* item;
+    size_t section_len;
+    size_t prop_len;
+    int closed;         /* the first occurrence of the section ended, later ones are ignored */
+} tb_ini_batch_entry;
+
+/* compares the name (name, len) with the string (str, str_len) */
+static int tb_ini_cmp_name(const char* name, size_t len, const char* str, size_t str_len)
+{
+    int cmp = memcmp(name, str, len < str_len ? len : str_len);
+    return cmp ? cmp : (len > str_len) - (len < str_len);
+}
+
+static int tb_ini_batch_entry_cmp(const void* left, const void* right)
+{
+    const tb_ini_batch_entry* l = left;
+    const tb_ini_batch_entry* r = right;
+
+    int cmp = tb_ini_cmp_name(l->item->section ? l->item->section : "", l->section_len, r->item->section ? r->item->section : "", r->section_len);
+    return cmp ? cmp : tb_ini_cmp_name(l->item->prop, l->prop_len, r->item->prop, r->prop_len);
+}
+
+/* returns the first entry in [first, last) with a section not less than the given one */
+static tb_ini_batch_entry* tb_ini_batch_find_section(tb_ini_batch_entry* first, tb_ini_batch_entry* last, const char* name, size_t len)
+{
+    while (first < last)
+    {
+        tb_ini_batch_entry* mid = first + (last - first) / 2;
+        if (tb_ini_cmp_name(mid->item->section ? mid->item->section : "", mid->section_len, name, len) < 0) first = mid + 1;
+        else last = mid;
+    }
+    return first;
+}
+
+/* returns the first entry in [first, last) with a prop not less than the given one (all entries share a section) */
+static tb_ini_batch_entry* tb_ini_batch_find_prop(tb_ini_batch_entry* first, tb_ini_batch_entry* last, const char* name, size_t len)
+{
+    while (first < last)
+    {
+        tb_ini_batch_entry* mid = first + (last - first) / 2;
+        if (tb_ini_cmp_name(mid->item->prop, mid->prop_len, name, len) < 0) first = mid + 1;
+        else last = mid;
+    }
+    return first;
+}
+
+static tb_ini_error tb_ini_batch_assign(tb_ini_batch_item* item, tb_ini_element* element)
+{
+    tb_ini_error error = TB_INI_OK;
+    int64_t i;
+    double d;
+
+    switch (item->type)
+    {
+    case TB_INI_TYPE_BOOL:
+        *(int*)item->dst = tb_ini_element_to_bool(element);
+        break;
+    case TB_INI_TYPE_INT:
+        if ((error = tb_ini_element_to_int64(element, &i)) != TB_INI_OK) break;
+        if (i < INT_MIN || i > INT_MAX) return TB_INI_OUT_OF_RANGE;
+        *(int*)item->dst = (int)i;
+        break;
+    case TB_INI_TYPE_INT64:
+        if ((error = tb_ini_element_to_int64(element, &i)) == TB_INI_OK) *(int64_t*)item->dst = i;
+        break;
+    case TB_INI_TYPE_FLOAT:
+        error = tb_ini_element_to_float_checked(element, item->dst);
+        break;
+    case TB_INI_TYPE_DOUBLE:
+        if ((error = tb_ini_element_to_double(element, &d)) == TB_INI_OK) *(double*)item->dst = d;
+        break;
+    case TB_INI_TYPE_STRING:
+        tb_ini_element_to_string(element, item->dst, item->dst_len);
+        break;
+    default:
+        return TB_INI_UNKOWN_ERROR;
+    }
+    return error;
+}
+
+static void tb_ini_batch_default(tb_ini_batch_item* item)
+{
+    if (!item->def) return;
+
+    switch (item->type)
+    {
+    case TB_INI_TYPE_BOOL:
+    case TB_INI_TYPE_INT:    *(int*)item->dst = *(const int*)item->def; break;
+    case TB_INI_TYPE_INT64:  *(int64_t*)item->dst = *(const int64_t*)item->def; break;
+    case TB_INI_TYPE_FLOAT:  *(float*)item->dst = *(const float*)item->def; break;
+    case TB_INI_TYPE_DOUBLE: *(double*)item->dst = *(const double*)item->def; break;
+    case TB_INI_TYPE_STRING: tb_ini_strncpy(item->dst, item->def, strlen(item->def), item->dst_len); break;
+    }
+}
+
+/* fallback if the lookup table could not be allocated */
+static size_t tb_ini_batch_each(const char* ini, const char* end, tb_ini_batch_item* items, size_t count)
+{
+    size_t found = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        tb_ini_element element;
+        tb_ini__query(ini, end, items[i].section, items[i].prop, &element);
+
+        items[i].error = element.error;
+        if (element.error == TB_INI_OK) items[i].error = tb_ini_batch_assign(&items[i], &element);
+
+        if (items[i].error == TB_INI_OK)    found++;
+        else                                tb_ini_batch_default(&items[i]);
+    }
+    return found;
+}
+
+static size_t tb_ini__batch(const char* ini, const char* end, tb_ini_batch_item* items, size_t count)
+{
+    tb_ini_batch_entry* entries = malloc(count * sizeof(tb_ini_batch_entry));
+    if (!entries) return tb_ini_batch_each(ini, end, items, count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        entries[i].item = &items[i];
+        entries[i].section_len = items[i].section ? strlen(items[i].section) : 0;
+        entries[i].prop_len = strlen(items[i].prop);
+        entries[i].closed = 0;
+        items[i].error = TB_INI_BAD_SECTION;
+    }
+    qsort(entries, count, sizeof(tb_ini_batch_entry), tb_ini_batch_entry_cmp);
+
+    /* properties before the first section belong to the NULL section (sorted to the front) */
+    tb_ini_batch_entry* first = entries;
+    tb_ini_batch_entry* last = entries;
+    while (last < entries + count && last->section_len == 0) (last++)->item->error = TB_INI_BAD_PROPERTY;
+
+    size_t found = 0;
+    size_t pending = count;
+
+    const char* cursor = ini;
+    while (pending && (cursor = tb_ini_skip_whitespace(cursor, end)) && !TB_INI_EOF(cursor, end))
+    {
+        if (*cursor == '[')
+        {
+            /* like tb_ini_query only the first occurrence of a section is searched */
+            for (; first < last; ++first)
+            {
+                if (first->item->error == TB_INI_BAD_PROPERTY) pending--;
+                first->closed = 1;
+            }
+
+            /* read section name and look up the range of items in this section */
+            const char* name = ++cursor;
+            while (!TB_INI_EOF(cursor, end) && *cursor != ']' && *cursor != '\n') cursor++;
+
+            size_t name_len = tb_ini_clip_tail(name, cursor) - name;
+            first = last = entries;
+            if (!TB_INI_EOF(cursor, end) && *cursor == ']' && name_len > 0)
+            {
+                first = tb_ini_batch_find_section(entries, entries + count, name, name_len);
+                last = first;
+                while (last < entries + count && !last->closed && last->section_len == name_len && memcmp(last->item->section, name, name_len) == 0)
+                {
+                    if (last->item->error == TB_INI_BAD_SECTION) last->item->error = TB_INI_BAD_PROPERTY;
+                    last++;
+                }
+            }
+
+            cursor = tb_ini_skip_line(cursor, end);
+            continue;
+        }
+
+        /* no items in this section, skip to the next line */
+        if (first == last)
+        {
+            cursor = tb_ini_skip_line(cursor, end);
+            continue;
+        }
+
+        tb_ini_element element;
+        const char* next = tb_ini_read_element(cursor, end, &element);
+
+        /* lines without a key value pair can not match any item */
+        tb_ini_batch_entry* entry = last;
+        if (element.error != TB_INI_BAD_PROPERTY) entry = tb_ini_batch_find_prop(first, last, element.name, element.name_len);
+
+        /* resolve every pending item that matches the property */
+        for (; entry < last && tb_ini_cmp_name(entry->item->prop, entry->prop_len, element.name, element.name_len) == 0; ++entry)
+        {
+            if (entry->item->error != TB_INI_BAD_PROPERTY) continue; /* first occurrence wins */
+
+            entry->item->error = element.error;
+            if (element.error == TB_INI_OK) entry->item->error = tb_ini_batch_assign(entry->item, &element);
+            if (entry->item->error == TB_INI_OK) found++;
+
+            pending--;
+        }
+
+        cursor = tb_ini_skip_line(next ? next : cursor, end);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+        if (items[i].error != TB_INI_OK) tb_ini_batch_default(&items[i]);
+
+    free(entries);
+    return found;
+}
+
+/* the member has to have the size of the bound type, strings need room for the terminator */
+static int tb_ini_binding_valid(const tb_ini_binding* binding)
+{
+    switch (binding->type)
+    {
+    case TB_INI_TYPE_BOOL:
+    case TB_INI_TYPE_INT:       return binding->size == sizeof(int);
+    case TB_INI_TYPE_INT64:     return binding->size == sizeof(int64_t);
+    case TB_INI_TYPE_FLOAT:     return binding->size == sizeof(float);
+    case TB_INI_TYPE_DOUBLE:    return binding->size == sizeof(double);
+    case TB_INI_TYPE_STRING:    return binding->size > 0;
+    }
+    return 0;
+}
+
+static size_t tb_ini__bind(const char* ini, const char* end, const tb_ini_binding* bindings, size_t count, void* dst, tb_ini_error* errors)
+{
+    /* items of the valid bindings, followed by the index of their binding */
+    tb_ini_batch_item* items = malloc(count * (sizeof(tb_ini_batch_item) + sizeof(size_t)));
+    if (!items)
+    {
+        for (size_t i = 0; errors && i < count; ++i) errors[i] = TB_INI_ALLOC_ERROR;
+        return 0;
+    }
+
+    size_t* index = (size_t*)(void*)(items + count);
+    size_t item_count = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const tb_ini_binding* binding = &bindings[i];
+        if (!tb_ini_binding_valid(binding))
+        {
+            if (errors) errors[i] = TB_INI_BAD_VALUE;
+            continue;
+        }
+
+        index[item_count] = i;
+        tb_ini_batch_item* item = &items[item_count++];
+
+        item->section = binding->section;
+        item->prop = binding->prop;
+        item->type = binding->type;
+        item->dst = (char*)dst + binding->offset;
+        item->dst_len = binding->size;
+
+        switch (binding->type)
+        {
+        case TB_INI_TYPE_INT64:     item->def = &binding->def.i64; break;
+        case TB_INI_TYPE_FLOAT:     item->def = &binding->def.f; break;
+        case TB_INI_TYPE_DOUBLE:    item->def = &binding->def.d; break;
+        case TB_INI_TYPE_STRING:    item->def = binding->def.s; break;
+        default:                    item->def = &binding->def.i; break;
+        }
+    }
+
+    size_t found = item_count ? tb_ini__batch(ini, end, items, item_count) : 0;
+
+    for (size_t i = 0; errors && i < item_count; ++i) errors[index[i]] = items[i].error;
+
+    free(items);
+    return found;
+}
+
+/* ----------------------------| Streaming |-------------------------------------------------------- */
+static size_t tb_ini_read_file(void* stream, char* buf, size_t size)
+{
+    return fread(buf, 1, size, stream);
+}
+
+/*
+ * returns the end of the record (section header or property) starting at cursor
+ * or NULL if more input is needed to complete it (grouped values may span lines)
+ */
+static const char* tb_ini_stream_record_end(const char* cursor, const char* end, int eof)
+{
+    const char* line_end = memchr(cursor, '\n', end - cursor);
+    if (!line_end) return eof ? end : NULL;
+    if (*cursor == '[') return line_end;
+
+    const char* value = memchr(cursor, '=', line_end - cursor);
+    if (!value) return line_end;
+
+    value = tb_ini_skip_whitespace(value + 1, line_end);
+    if (value == line_end || *value != '{') return line_end;
+
+    const char* close = memchr(value, '}', end - value);
+    if (!close) return eof ? end : NULL;
+
+    line_end = memchr(close, '\n', end - close);
+    if (!line_end) return eof ? end : NULL;
+    return line_end;
+}
+
+typedef struct
+{
+    const tb_ini_handler* handler;
+    tb_ini_element section;
+    char* name_buf;     /* if not NULL section names are copied to this buffer */
+    size_t name_cap;
+    tb_ini_error result;
+    int stop;
+} tb_ini_walk_state;
+
+/* reads the section header in [cursor, end) and copies its name to the name buffer if there is one */
+static tb_ini_error tb_ini_walk_section(tb_ini_walk_state* state, const char* cursor, const char* end)
+{
+    const char* name = cursor + 1;
+    const char* close = memchr(name, ']', end - name);
+
+    tb_ini_element* section = &state->section;
+    section->name = NULL;
+    section->name_len = 0;
+    section->start = cursor;
+    section->len = 0;
+    section->error = TB_INI_BAD_SECTION;
+
+    if (!close) return TB_INI_OK;
+
+    size_t len = tb_ini_clip_tail(name, close) - name;
+    if (state->name_buf)
+    {
+        if (len >= state->name_cap)
+        {
+            char* buf = realloc(state->name_buf, len + 1);
+            if (!buf) return TB_INI_ALLOC_ERROR;
+
+            state->name_buf = buf;
+            state->name_cap = len + 1;
+        }
+
+        memcpy(state->name_buf, name, len);
+        state->name_buf[len] = '\0';
+        name = state->name_buf;
+    }
+
+    section->name = name;
+    section->name_len = len;
+    section->start = end;
+    section->error = TB_INI_OK;
+    return TB_INI_OK;
+}
+
+/* reports all complete records in [cursor, end) and returns the start of the first incomplete one */
+static const char* tb_ini_walk_records(tb_ini_walk_state* state, const char* cursor, const char* end, int eof)
+{
+    const tb_ini_handler* handler = state->handler;
+    while (!state->stop && (cursor = tb_ini_skip_whitespace(cursor, end)) < end)
+    {
+        const char* record_end = tb_ini_stream_record_end(cursor, end, eof);
+        if (!record_end) break;
+
+        if (*cursor == '[')
+        {
+            tb_ini_error error = tb_ini_walk_section(state, cursor, record_end);
+            if (error != TB_INI_OK)
+            {
+                state->result = error;
+                state->stop = 1;
+                break;
+            }
+
+            if (state->result == TB_INI_OK) state->result = state->section.error;
+            if (handler->section) state->stop = handler->section(handler->user, &state->section);
+        }
+        else
+        {
+            tb_ini_element prop;
+            tb_ini_read_element(cursor, record_end, &prop);
+
+            if (state->result == TB_INI_OK) state->result = prop.error;
+            if (handler->property) state->stop = handler->property(handler->user, &state->section, &prop);
+        }
+
+        cursor = record_end;
+    }
+    return cursor;
+}
+
+static tb_ini_error tb_ini__walk(const char* ini, const char* end, const tb_ini_handler* handler)
+{
+    tb_ini_walk_state state = { 0 };
+    state.handler = handler;
+
+    tb_ini_walk_records(&state, ini, end, 1);
+    return state.result;
+}
+
+/* ----------------------------| Public API |------------------------------------------------------- */
+char* tb_ini_query(char* ini, const char* section, const char* prop, tb_ini_element* element)
+{
+    return (char*)tb_ini__query(ini, NULL, section, prop, element);
+}
+
+char* tb_ini_query_section(char* section, const char* prop, tb_ini_element* element)
+{
+    return (char*)tb_ini__query_section(section, NULL, prop, element);
+}
+
+char* tb_ini_group_next(char* ini, const char* group, tb_ini_element* element)
+{
+    return (char*)tb_ini__group_next(ini, NULL, group, element);
+}
+
+char* tb_ini_property_next(char* ini, tb_ini_element* element)
+{
+    return (char*)tb_ini__property_next(ini, NULL, element);
+}
+
+void tb_ini_cursor_init(tb_ini_cursor* cursor, char* ini, const char* group)
+{
+    cursor->pos = ini;
+    cursor->end = NULL;
+    cursor->group = group;
+    cursor->group_len = group ? strlen(group) : 0;
+}
+
+void tb_ini_cursor_init_n(tb_ini_cursor* cursor, const char* ini, size_t len, const char* group)
+{
+    tb_ini_cursor_init(cursor, NULL, group);
+    cursor->pos = ini;
+    cursor->end = ini + len;
+}
+
+int tb_ini_cursor_next(tb_ini_cursor* cursor, tb_ini_element* section)
+{
+    const char* end = cursor->end;
+    const char* pos = cursor->pos;
+    while (pos && (pos = tb_ini_next_header(pos, end)) != NULL)
+    {
+        const char* name = pos + 1;
+        pos = tb_ini_skip_line(name, end);
+
+        const char* close = memchr(name, ']', pos - name);
+        if (!close) continue;
+
+        /* strip the group prefix */
+        if (cursor->group)
+        {
+            if ((size_t)(close - name) <= cursor->group_len + 1
+                || memcmp(name, cursor->group, cursor->group_len) != 0
+                || name[cursor->group_len] != '.') continue;
+
+            name += cursor->group_len + 1;
+        }
+
+        size_t name_len = tb_ini_clip_tail(name, close) - name;
+        if (name_len == 0) continue;
+
+        section->name = name;
+        section->name_len = name_len;
+        section->start = pos;
+        section->len = 0;
+        section->error = TB_INI_OK;
+
+        cursor->pos = pos;
+        return 1;
+    }
+
+    cursor->pos = NULL;
+    return 0;
+}
+
+size_t tb_ini_cursor_count(tb_ini_cursor* cursor, tb_ini_element* section)
+{
+    const char* pos = section->start;
+    section->len = 0;
+
+    tb_ini_element prop;
+    const char* next;
+    while ((next = tb_ini__property_next(pos, cursor->end, &prop)) != NULL)
+    {
+        if (prop.error != TB_INI_OK)
+        {
+            section->error = TB_INI_BAD_VALUE;
+            break;
+        }
+        section->len++;
+        pos = next;
+    }
+
+    /* the counted properties do not need to be searched for the next header again */
+    if (cursor->pos && pos > cursor->pos) cursor->pos = pos;
+    return section->len;
+}
+
+int tb_ini_element_to_bool(tb_ini_element* element) { return (element->len == 4 && memcmp(element->start, "true", 4) == 0) ? 1 : 0; }
 
-    element->len = tb_ini_clip_tail(stream) - element->start;
-    
-    return (*stream != '\0' && *stream != '}') ? ++stream : NULL;
+int tb_ini_element_to_int(tb_ini_element* element)
+{
+    int64_t value;
+    if (tb_ini_element_to_int64(element, &value) != TB_INI_OK) return 0;
+    return (value >= INT_MIN && value <= INT_MAX) ? (int)value : 0;
+}
+
+float tb_ini_element_to_float(tb_ini_element* element)
+{
+    float value;
+    return (tb_ini_element_to_float_checked(element, &value) == TB_INI_OK) ? value : 0.0f;
+}
+
+tb_ini_error tb_ini_element_to_int64(const tb_ini_element* element, int64_t* value)
+{
+    const char* cursor = element->start;
+    const char* end = cursor + element->len;
+    if (!cursor || cursor == end) return TB_INI_BAD_VALUE;
+
+    int negative = (*cursor == '-');
+    if (*cursor == '-' || *cursor == '+') cursor++;
+
+    unsigned base = 10;
+    if (end - cursor > 2 && cursor[0] == '0' && (cursor[1] == 'x' || cursor[1] == 'X'))         { base = 16; cursor += 2; }
+    else if (end - cursor > 2 && cursor[0] == '0' && (cursor[1] == 'b' || cursor[1] == 'B'))    { base = 2; cursor += 2; }
+
+    if (cursor == end) return TB_INI_BAD_VALUE;
+
+    /* up to this many digits can not overflow, so the check is skipped for them */
+    size_t safe_digits = (base == 10) ? 19 : (base == 16) ? 16 : 64;
+
+    uint64_t result = 0;
+    for (size_t i = 0; cursor < end; ++cursor, ++i)
+    {
+        unsigned digit = tb_ini_digit(*cursor);
+        if (digit >= base) return TB_INI_BAD_VALUE;
+        if (i >= safe_digits && result > (UINT64_MAX - digit) / base) return TB_INI_OUT_OF_RANGE;
+        result = result * base + digit;
+    }
+
+    if (result > (negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX)) return TB_INI_OUT_OF_RANGE;
+
+    *value = negative ? -(int64_t)(result - 1) - 1 : (int64_t)result;
+    return TB_INI_OK;
+}
+
+tb_ini_error tb_ini_element_to_double(const tb_ini_element* element, double* value)
+{
+    const char* cursor = element->start;
+    const char* end = cursor + element->len;
+    if (!cursor || cursor == end) return TB_INI_BAD_VALUE;
+
+    int negative = (*cursor == '-');
+    if (*cursor == '-' || *cursor == '+') cursor++;
+
+    /* inf and nan are left to strtod */
+    if (cursor < end && (*cursor == 'i' || *cursor == 'I' || *cursor == 'n' || *cursor == 'N'))
+        return tb_ini_strtod(element->start, element->len, value);
+
+    /* read up to 19 significant digits into the mantissa, remember if any non-zero digit got dropped */
+    uint64_t mantissa = 0;
+    int64_t exponent = 0;
+    int digits = 0;
+    int truncated = 0;
+    int valid = 0;
+
+    for (; cursor < end && *cursor >= '0' && *cursor <= '9'; ++cursor, valid = 1)
+    {
+        if (digits < 19)    { mantissa = mantissa * 10 + (*cursor - '0'); digits += (mantissa != 0); }
+        else                { exponent++; truncated |= (*cursor != '0'); }
+    }
+
+    if (cursor < end && *cursor == '.')
+    {
+        for (++cursor; cursor < end && *cursor >= '0' && *cursor <= '9'; ++cursor, valid = 1)
+        {
+            if (digits < 19)    { mantissa = mantissa * 10 + (*cursor - '0'); digits += (mantissa != 0); exponent--; }
+            else                { truncated |= (*cursor != '0'); }
+        }
+    }
+
+    if (!valid) return TB_INI_BAD_VALUE;
+
+    if (cursor < end && (*cursor == 'e' || *cursor == 'E'))
+    {
+        if (++cursor < end && (*cursor == '-' || *cursor == '+')) cursor++;
+        int exp_negative = (*(cursor - 1) == '-');
+
+        if (cursor == end || *cursor < '0' || *cursor > '9') return TB_INI_BAD_VALUE;
+
+        int64_t exp = 0;
+        for (; cursor < end && *cursor >= '0' && *cursor <= '9'; ++cursor)
+            if (exp < 100000) exp = exp * 10 + (*cursor - '0');
+
+        exponent += exp_negative ? -exp : exp;
+    }
+
+    if (cursor != end) return TB_INI_BAD_VALUE;
+
+    if (mantissa == 0)
+    {
+        *value = negative ? -0.0 : 0.0;
+        return TB_INI_OK;
+    }
+
+    /*
+     * fast path (Clinger): if the mantissa and the power of ten are both exactly representable
+     * as a double, a single multiplication or division yields the correctly rounded result
+     */
+    if (!truncated && mantissa <= ((uint64_t)1 << 53) && exponent >= -22 && exponent <= 22)
+    {
+        double result = (double)mantissa;
+        result = (exponent < 0) ? result / tb_ini_pow10[-exponent] : result * tb_ini_pow10[exponent];
+
+        *value = negative ? -result : result;
+        return TB_INI_OK;
+    }
+
+    return tb_ini_strtod(element->start, element->len, value);
+}
+
+size_t tb_ini_element_to_string(tb_ini_element* element, char* dst, size_t dst_len)
+{
+    return tb_ini_strncpy(dst, element->start, element->len, dst_len);
+}
+
+size_t tb_ini_name(const tb_ini_element* element, char* dst, size_t dst_len)
+{
+    if (element->error == TB_INI_OK) return tb_ini_strncpy(dst, element->name, element->name_len, dst_len);
+
+    dst[0] = '\0';
+    return 0;
+}
+
+int tb_ini_bool(char* ini, const char* section, const char* prop, int def)
+{
+    return tb_ini__bool(ini, NULL, section, prop, def);
+}
+
+int tb_ini_int(char* ini, const char* section, const char* prop, int def)
+{
+    return tb_ini__int(ini, NULL, section, prop, def);
+}
+
+float tb_ini_float(char* ini, const char* section, const char* prop, float def)
+{
+    return tb_ini__float(ini, NULL, section, prop, def);
+}
+
+size_t tb_ini_string(char* ini, const char* section, const char* prop, char* dst, size_t dst_len)
+{
+    return tb_ini__string(ini, NULL, section, prop, dst, dst_len);
+}
+
+int64_t tb_ini_int64(char* ini, const char* section, const char* prop, int64_t def)
+{
+    return tb_ini__int64(ini, NULL, section, prop, def);
+}
+
+double tb_ini_double(char* ini, const char* section, const char* prop, double def)
+{
+    return tb_ini__double(ini, NULL, section, prop, def);
+}
+
+int tb_ini_parse(char* ini, const char* section, const char* prop, tb_ini_parse_func parse)
+{
+    return tb_ini__parse(ini, NULL, section, prop, parse);
+}
+
+char* tb_ini_csv(char* ini, const char* section, const char* prop, tb_ini_element* element)
+{
+    return (char*)tb_ini__csv(ini, NULL, section, prop, element);
+}
+
+char* tb_ini_csv_step(char* stream, tb_ini_element* element)
+{
+    return (char*)tb_ini__csv_step(stream, NULL, element);
+}
+
+size_t tb_ini_csv_to_int_array(char* ini, const char* section, const char* prop, int* dst, size_t dst_len, tb_ini_element* element)
+{
+    return tb_ini__csv_to_array(ini, NULL, section, prop, TB_INI_TYPE_INT, dst, dst_len, element);
+}
+
+size_t tb_ini_csv_to_float_array(char* ini, const char* section, const char* prop, float* dst, size_t dst_len, tb_ini_element* element)
+{
+    return tb_ini__csv_to_array(ini, NULL, section, prop, TB_INI_TYPE_FLOAT, dst, dst_len, element);
+}
+
+/* ----------------------------| Length-bounded API |----------------------------------------------- */
+const char* tb_ini_query_n(const char* ini, size_t len, const char* section, const char* prop, tb_ini_element* element)
+{
+    return tb_ini__query(ini, ini + len, section, prop, element);
+}
+
+const char* tb_ini_query_section_n(const char* section, size_t len, const char* prop, tb_ini_element* element)
+{
+    return tb_ini__query_section(section, section + len, prop, element);
+}
+
+const char* tb_ini_group_next_n(const char* ini, size_t len, const char* group, tb_ini_element* element)
+{
+    return tb_ini__group_next(ini, ini + len, group, element);
+}
+
+const char* tb_ini_property_next_n(const char* ini, size_t len, tb_ini_element* element)
+{
+    return tb_ini__property_next(ini, ini + len, element);
+}
+
+int tb_ini_bool_n(const char* ini, size_t len, const char* section, const char* prop, int def)
+{
+    return tb_ini__bool(ini, ini + len, section, prop, def);
+}
+
+int tb_ini_int_n(const char* ini, size_t len, const char* section, const char* prop, int def)
+{
+    return tb_ini__int(ini, ini + len, section, prop, def);
+}
+
+float tb_ini_float_n(const char* ini, size_t len, const char* section, const char* prop, float def)
+{
+    return tb_ini__float(ini, ini + len, section, prop, def);
+}
+
+size_t tb_ini_string_n(const char* ini, size_t len, const char* section, const char* prop, char* dst, size_t dst_len)
+{
+    return tb_ini__string(ini, ini + len, section, prop, dst, dst_len);
+}
+
+int64_t tb_ini_int64_n(const char* ini, size_t len, const char* section, const char* prop, int64_t def)
+{
+    return tb_ini__int64(ini, ini + len, section, prop, def);
+}
+
+double tb_ini_double_n(const char* ini, size_t len, const char* section, const char* prop, double def)
+{
+    return tb_ini__double(ini, ini + len, section, prop, def);
+}
+
+int tb_ini_parse_n(const char* ini, size_t len, const char* section, const char* prop, tb_ini_parse_func parse)
+{
+    return tb_ini__parse(ini, ini + len, section, prop, parse);
+}
+
+const char* tb_ini_csv_n(const char* ini, size_t len, const char* section, const char* prop, tb_ini_element* element)
+{
+    return tb_ini__csv(ini, ini + len, section, prop, element);
+}
+
+const char* tb_ini_csv_step_n(const char* stream, size_t len, tb_ini_element* element)
+{
+    return tb_ini__csv_step(stream, stream ? stream + len : NULL, element);
+}
+
+size_t tb_ini_csv_to_int_array_n(const char* ini, size_t len, const char* section, const char* prop, int* dst, size_t dst_len, tb_ini_element* element)
+{
+    return tb_ini__csv_to_array(ini, ini + len, section, prop, TB_INI_TYPE_INT, dst, dst_len, element);
+}
+
+size_t tb_ini_csv_to_float_array_n(const char* ini, size_t len, const char* section, const char* prop, float* dst, size_t dst_len, tb_ini_element* element)
+{
+    return tb_ini__csv_to_array(ini, ini + len, section, prop, TB_INI_TYPE_FLOAT, dst, dst_len, element);
+}
+
+size_t tb_ini_batch(char* ini, tb_ini_batch_item* items, size_t count)
+{
+    return tb_ini__batch(ini, NULL, items, count);
+}
+
+size_t tb_ini_batch_n(const char* ini, size_t len, tb_ini_batch_item* items, size_t count)
+{
+    return tb_ini__batch(ini, ini + len, items, count);
+}
+
+size_t tb_ini_bind(char* ini, const tb_ini_binding* bindings, size_t count, void* dst, tb_ini_error* errors)
+{
+    return tb_ini__bind(ini, NULL, bindings, count, dst, errors);
+}
+
+size_t tb_ini_bind_n(const char* ini, size_t len, const tb_ini_binding* bindings, size_t count, void* dst, tb_ini_error* errors)
+{
+    return tb_ini__bind(ini, ini + len, bindings, count, dst, errors);
+}
+
+tb_ini_error tb_ini_walk(char* ini, const tb_ini_handler* handler)
+{
+    return tb_ini__walk(ini, ini + strlen(ini), handler);
+}
+
+tb_ini_error tb_ini_walk_n(const char* ini, size_t len, const tb_ini_handler* handler)
+{
+    return tb_ini__walk(ini, ini + len, handler);
+}
+
+tb_ini_error tb_ini_stream(tb_ini_read_func read, void* stream, size_t chunk_size, const tb_ini_handler* handler)
+{
+    if (!chunk_size) chunk_size = TB_INI_STREAM_CHUNK_SIZE;
+
+    size_t cap = chunk_size;
+    char* buf = malloc(cap);
+
+    tb_ini_walk_state state = { 0 };
+    state.handler = handler;
+    state.name_buf = malloc(1);
+    state.name_cap = 1;
+
+    if (!buf || !state.name_buf)
+    {
+        free(buf);
+        free(state.name_buf);
+        return TB_INI_ALLOC_ERROR;
+    }
+
+    size_t len = 0; /* bytes in the buffer */
+    size_t pos = 0; /* start of the first incomplete record */
+    int eof = 0;
+
+    while (!eof && !state.stop)
+    {
+        /* move the incomplete record to the front and refill the buffer */
+        memmove(buf, buf + pos, len - pos);
+        len -= pos;
+        pos = 0;
+
+        if (len == cap)
+        {
+            char* grown = realloc(buf, cap * 2);
+            if (!grown)
+            {
+                state.result = TB_INI_ALLOC_ERROR;
+                break;
+            }
+
+            buf = grown;
+            cap *= 2;
+        }
+
+        size_t read_len = read(stream, buf + len, cap - len);
+        eof = (read_len == 0);
+        len += read_len;
+
+        pos = tb_ini_walk_records(&state, buf, buf + len, eof) - buf;
+    }
+
+    free(state.name_buf);
+    free(buf);
+    return state.result;
+}
+
+tb_ini_error tb_ini_stream_file(FILE* const file, size_t chunk_size, const tb_ini_handler* handler)
+{
+    if (!file) return TB_INI_IO_ERROR;
+
+    tb_ini_error error = tb_ini_stream(tb_ini_read_file, file, chunk_size, handler);
+    return (error == TB_INI_OK && ferror(file)) ? TB_INI_IO_ERROR : error;
 }
 
 const char* tb_ini_get_error_desc(tb_ini_error error)
@@ -318,6 +1432,9 @@ const char* tb_ini_get_error_desc(tb_ini_error error)
     case TB_INI_BAD_VALUE:          return "bad value";
     case TB_INI_BAD_SECTION:        return "bad section";
     case TB_INI_BAD_PROPERTY:       return "bad property";
+    case TB_INI_OUT_OF_RANGE:       return "value out of range";
+    case TB_INI_ALLOC_ERROR:        return "allocation failed";
+    case TB_INI_IO_ERROR:           return "io error";
     default:                        return "unkown error";
     }
-}
\ No newline at end of file
+}
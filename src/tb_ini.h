@@ -2,6 +2,8 @@
 #define TB_INI_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 
 typedef enum
 {
@@ -10,14 +12,18 @@ typedef enum
     TB_INI_BAD_VALUE,
     TB_INI_BAD_SECTION,
     TB_INI_BAD_PROPERTY,
-    TB_INI_UNKOWN_ERROR
+    TB_INI_UNKOWN_ERROR,
+    TB_INI_OUT_OF_RANGE,
+    TB_INI_ALLOC_ERROR,
+    TB_INI_IO_ERROR
 } tb_ini_error;
 
+/* name and start are const since the length-bounded functions work on read-only input */
 typedef struct
 {
-    char* name;
+    const char* name;
     size_t name_len;    /* bytelen of name */
-    char* start;
+    const char* start;
     size_t len;         /* bytelen of value or num of properites for sections */
     tb_ini_error error;
 } tb_ini_element;
@@ -40,12 +46,44 @@ char* tb_ini_group_next(char* ini, const char* group, tb_ini_element* element);
 /* returns the next property (after the ini cursor) */
 char* tb_ini_property_next(char* ini, tb_ini_element* element);
 
+/*
+ * section cursor
+ * walks the sections (or only the sections of a group if group is not NULL) once in file order
+ * tb_ini_cursor_next returns 0 if there are no more sections, else the element holds the name of
+ * the section (without the group prefix) and start points to its first property
+ * the number of properties is not counted (len is 0) until tb_ini_cursor_count is called
+ * which also moves the cursor past the counted properties
+ */
+typedef struct
+{
+    const char* pos;
+    const char* end;    /* NULL for zero terminated input */
+    const char* group;
+    size_t group_len;
+} tb_ini_cursor;
+
+void   tb_ini_cursor_init(tb_ini_cursor* cursor, char* ini, const char* group);
+void   tb_ini_cursor_init_n(tb_ini_cursor* cursor, const char* ini, size_t len, const char* group);
+int    tb_ini_cursor_next(tb_ini_cursor* cursor, tb_ini_element* section);
+size_t tb_ini_cursor_count(tb_ini_cursor* cursor, tb_ini_element* section);
+
 /* unchecked conversion from element to different types */
 int     tb_ini_element_to_bool(tb_ini_element* element);
 int     tb_ini_element_to_int(tb_ini_element* element);
 float   tb_ini_element_to_float(tb_ini_element* element);
 size_t  tb_ini_element_to_string(tb_ini_element* element, char* dst, size_t dst_len);
 
+/*
+ * checked, locale-independent conversion of numbers (never reads past element->len)
+ * integers may have a sign and a 0x (hex) or 0b (binary) prefix
+ * returns TB_INI_BAD_VALUE if the element is not a number or TB_INI_OUT_OF_RANGE if it does not fit
+ * (the float functions also treat finite values beyond FLT_MAX as out of range).
+ * numbers the fast path can not round are converted with strtod_l in the C locale, on Linux it
+ * needs _GNU_SOURCE, else strtod with the decimal point of the current locale is used
+ */
+tb_ini_error tb_ini_element_to_int64(const tb_ini_element* element, int64_t* value);
+tb_ini_error tb_ini_element_to_double(const tb_ini_element* element, double* value);
+
 /* copies the name of the element into the dst buffer (copies at most dst_len bytes)*/
 size_t tb_ini_name(const tb_ini_element* element, char* dst, size_t dst_len);
 
@@ -54,6 +92,8 @@ int     tb_ini_bool(char* ini, const char* section, const char* prop, int def);
 int     tb_ini_int(char* ini, const char* section, const char* prop, int def);
 float   tb_ini_float(char* ini, const char* section, const char* prop, float def);
 size_t  tb_ini_string(char* ini, const char* section, const char* prop, char* dst, size_t dst_len);
+int64_t tb_ini_int64(char* ini, const char* section, const char* prop, int64_t def);
+double  tb_ini_double(char* ini, const char* section, const char* prop, double def);
 
 typedef int(*tb_ini_parse_func)(const char* start, size_t len);
 int     tb_ini_parse(char* ini, const char* section, const char* prop, tb_ini_parse_func parse);
@@ -66,6 +106,168 @@ int     tb_ini_parse(char* ini, const char* section, const char* prop, tb_ini_pa
 char* tb_ini_csv(char* ini, const char* section, const char* prop, tb_ini_element* element);
 char* tb_ini_csv_step(char* stream, tb_ini_element* element);
 
+/*
+ * decode a whole grouped value like {1, 2, 3} into dst (at most dst_len values)
+ * ints may use the formats of tb_ini_element_to_int64 but have to fit into an int
+ * returns the number of values written. on success element is the same as for tb_ini_csv,
+ * else element->error is set and element points to the first value that could not be
+ * decoded (its index is the return value). if dst is full TB_INI_OUT_OF_RANGE is set.
+ * to decode into a tb_array resize it to the count of tb_ini_csv and pass its data.
+ */
+size_t tb_ini_csv_to_int_array(char* ini, const char* section, const char* prop, int* dst, size_t dst_len, tb_ini_element* element);
+size_t tb_ini_csv_to_float_array(char* ini, const char* section, const char* prop, float* dst, size_t dst_len, tb_ini_element* element);
+
+/*
+ * length-bounded variants of the functions above
+ * the input does not need to be zero terminated and is never written to, so these
+ * can be used directly on read-only memory (e.g. a memory mapped file)
+ * no byte at or after ini + len is read, returned cursors point into the same buffer
+ */
+const char* tb_ini_query_n(const char* ini, size_t len, const char* section, const char* prop, tb_ini_element* element);
+const char* tb_ini_query_section_n(const char* section, size_t len, const char* prop, tb_ini_element* element);
+const char* tb_ini_group_next_n(const char* ini, size_t len, const char* group, tb_ini_element* element);
+const char* tb_ini_property_next_n(const char* ini, size_t len, tb_ini_element* element);
+
+int     tb_ini_bool_n(const char* ini, size_t len, const char* section, const char* prop, int def);
+int     tb_ini_int_n(const char* ini, size_t len, const char* section, const char* prop, int def);
+float   tb_ini_float_n(const char* ini, size_t len, const char* section, const char* prop, float def);
+size_t  tb_ini_string_n(const char* ini, size_t len, const char* section, const char* prop, char* dst, size_t dst_len);
+int64_t tb_ini_int64_n(const char* ini, size_t len, const char* section, const char* prop, int64_t def);
+double  tb_ini_double_n(const char* ini, size_t len, const char* section, const char* prop, double def);
+int     tb_ini_parse_n(const char* ini, size_t len, const char* section, const char* prop, tb_ini_parse_func parse);
+
+const char* tb_ini_csv_n(const char* ini, size_t len, const char* section, const char* prop, tb_ini_element* element);
+const char* tb_ini_csv_step_n(const char* stream, size_t len, tb_ini_element* element);
+size_t tb_ini_csv_to_int_array_n(const char* ini, size_t len, const char* section, const char* prop, int* dst, size_t dst_len, tb_ini_element* element);
+size_t tb_ini_csv_to_float_array_n(const char* ini, size_t len, const char* section, const char* prop, float* dst, size_t dst_len, tb_ini_element* element);
+
+/*
+ * batch queries
+ * resolves all items in a single linear scan of the ini instead of one scan per query
+ * dst has to point to an int for bools and ints, an int64_t, a float, a double or a
+ * char buffer of dst_len bytes for strings. def points to a value of the same type (a zero
+ * terminated string for strings) that is written to dst if the property is not found,
+ * if def is NULL dst is left untouched. properties are matched by their full name,
+ * a NULL section refers to the properties before the first section.
+ * error is set for every item, returns the number of items found without error
+ */
+typedef enum
+{
+    TB_INI_TYPE_BOOL,
+    TB_INI_TYPE_INT,
+    TB_INI_TYPE_INT64,
+    TB_INI_TYPE_FLOAT,
+    TB_INI_TYPE_DOUBLE,
+    TB_INI_TYPE_STRING
+} tb_ini_type;
+
+typedef struct
+{
+    const char* section;
+    const char* prop;
+    tb_ini_type type;
+    void* dst;
+    size_t dst_len;
+    const void* def;
+    tb_ini_error error;
+} tb_ini_batch_item;
+
+size_t tb_ini_batch(char* ini, tb_ini_batch_item* items, size_t count);
+size_t tb_ini_batch_n(const char* ini, size_t len, tb_ini_batch_item* items, size_t count);
+
+/*
+ * struct binding
+ * a table of bindings maps properties to members of a struct, tb_ini_bind resolves the whole
+ * table with a single tb_ini_batch scan and writes the values (or defaults) into the struct at dst
+ * if errors is not NULL it receives one error per binding, returns the number of properties found
+ * the TB_INI_BIND_* macros fill in the offset and size of the member and work well with X-macros.
+ * members have the C type of the binding (int for bools), string members have to be char arrays.
+ * the macros do not compile for members of another size (or string pointers with GCC/Clang),
+ * tb_ini_bind reports TB_INI_BAD_VALUE for bindings whose size does not match and skips them:
+ *
+ *  #define WINDOW_CONFIG(X)                                        \
+ *      X(TB_INI_BIND_STRING(window_config, title, "window", "title", "untitled"))  \
+ *      X(TB_INI_BIND_INT(window_config, width, "window", "width", 800))
+ *
+ *  #define BINDING(b) b,
+ *  static const tb_ini_binding bindings[] = { WINDOW_CONFIG(BINDING) };
+ */
+typedef union
+{
+    int i;
+    int64_t i64;
+    float f;
+    double d;
+    const char* s;
+} tb_ini_value;
+
+typedef struct
+{
+    const char* section;
+    const char* prop;
+    tb_ini_type type;
+    size_t offset;
+    size_t size;        /* size of the member (buffer size for strings) */
+    tb_ini_value def;
+} tb_ini_binding;
+
+/* compile time checks, both evaluate to 0 and fail with a negative array size */
+#define TB_INI_BIND_MEMBER(type, member)        (((type*)0)->member)
+#define TB_INI_BIND_SIZE(type, member, size)    (0 * sizeof(char[(sizeof(TB_INI_BIND_MEMBER(type, member)) == (size)) ? 1 : -1]))
+
+#if defined(__GNUC__)
+#define TB_INI_BIND_ARRAY(type, member) (0 * sizeof(char[__builtin_types_compatible_p(__typeof__(TB_INI_BIND_MEMBER(type, member)), __typeof__(&TB_INI_BIND_MEMBER(type, member)[0])) ? -1 : 1]))
+#else
+#define TB_INI_BIND_ARRAY(type, member) (0 * sizeof(TB_INI_BIND_MEMBER(type, member)[0]))
+#endif
+
+#define TB_INI_BIND(t, type, member, section, prop, field, def, check) { (section), (prop), (t), offsetof(type, member) + (check), sizeof(TB_INI_BIND_MEMBER(type, member)), { .field = (def) } }
+
+#define TB_INI_BIND_BOOL(type, member, section, prop, def)      TB_INI_BIND(TB_INI_TYPE_BOOL, type, member, section, prop, i, def, TB_INI_BIND_SIZE(type, member, sizeof(int)))
+#define TB_INI_BIND_INT(type, member, section, prop, def)       TB_INI_BIND(TB_INI_TYPE_INT, type, member, section, prop, i, def, TB_INI_BIND_SIZE(type, member, sizeof(int)))
+#define TB_INI_BIND_INT64(type, member, section, prop, def)     TB_INI_BIND(TB_INI_TYPE_INT64, type, member, section, prop, i64, def, TB_INI_BIND_SIZE(type, member, sizeof(int64_t)))
+#define TB_INI_BIND_FLOAT(type, member, section, prop, def)     TB_INI_BIND(TB_INI_TYPE_FLOAT, type, member, section, prop, f, def, TB_INI_BIND_SIZE(type, member, sizeof(float)))
+#define TB_INI_BIND_DOUBLE(type, member, section, prop, def)    TB_INI_BIND(TB_INI_TYPE_DOUBLE, type, member, section, prop, d, def, TB_INI_BIND_SIZE(type, member, sizeof(double)))
+#define TB_INI_BIND_STRING(type, member, section, prop, def)    TB_INI_BIND(TB_INI_TYPE_STRING, type, member, section, prop, s, def, TB_INI_BIND_ARRAY(type, member))
+
+size_t tb_ini_bind(char* ini, const tb_ini_binding* bindings, size_t count, void* dst, tb_ini_error* errors);
+size_t tb_ini_bind_n(const char* ini, size_t len, const tb_ini_binding* bindings, size_t count, void* dst, tb_ini_error* errors);
+
+/*
+ * walks over all section headers and properties of the buffer in file order and calls the handler
+ * the section element points to the name of the current section (NULL before the first section)
+ * and start points to the end of its header line (for malformed headers to the '[' of the header)
+ * callbacks return 0 to continue or non-zero to stop, returns the first error encountered
+ */
+typedef int (*tb_ini_section_func)(void* user, const tb_ini_element* section);
+typedef int (*tb_ini_property_func)(void* user, const tb_ini_element* section, const tb_ini_element* prop);
+
+typedef struct
+{
+    tb_ini_section_func section;    /* may be NULL */
+    tb_ini_property_func property;  /* may be NULL */
+    void* user;
+} tb_ini_handler;
+
+tb_ini_error tb_ini_walk(char* ini, const tb_ini_handler* handler);
+tb_ini_error tb_ini_walk_n(const char* ini, size_t len, const tb_ini_handler* handler);
+
+/*
+ * streaming parser
+ * works like tb_ini_walk but reads the input in chunks of chunk_size bytes (0 for the default)
+ * through the read function, read returns the number of bytes written to buf, 0 at the end of the input
+ * records spanning chunk boundaries are handled, memory use is bounded by the chunk size
+ * (the buffer only grows if a single record is larger than a chunk)
+ * the elements point into internal buffers and are only valid during the callback
+ * erroneous records are passed to the callbacks as well
+ */
+#define TB_INI_STREAM_CHUNK_SIZE    (1 << 16)
+
+typedef size_t (*tb_ini_read_func)(void* stream, char* buf, size_t size);
+
+tb_ini_error tb_ini_stream(tb_ini_read_func read, void* stream, size_t chunk_size, const tb_ini_handler* handler);
+tb_ini_error tb_ini_stream_file(FILE* const file, size_t chunk_size, const tb_ini_handler* handler);
+
 /* returns a string describing the error */
 const char* tb_ini_get_error_desc(tb_ini_error error);
 
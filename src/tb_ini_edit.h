@@ -0,0 +1,65 @@
+#ifndef TB_INI_EDIT_H
+#define TB_INI_EDIT_H
+
+#include "tb_ini.h"
+
+/*
+ * Editing of ini buffers without rewriting them.
+ * The original text is never modified (or copied), edits are stored as a sorted list of patches
+ * that replace ranges of the original with text from an append-only buffer (a piece table).
+ * Everything that is not edited, including comments and formatting, stays as it is. The result
+ * is written out by gathering the untouched ranges and the patches in a single writev.
+ *
+ * Properties are matched by their full name in the first section with the given name,
+ * a NULL section refers to the properties before the first section. New properties are added
+ * after the last property of their section, new sections at the end. Values are written as
+ * they are and must not contain line breaks.
+ */
+typedef struct
+{
+    size_t start;       /* replaced range of the original */
+    size_t len;
+    size_t text;        /* replacement in the edit buffer */
+    size_t text_len;
+} tb_ini_edit_patch;
+
+typedef struct
+{
+    const char* ini;
+    size_t len;
+
+    tb_ini_edit_patch* patches;
+    size_t patch_count;
+    size_t patch_cap;
+
+    char* buf;
+    size_t buf_len;
+    size_t buf_cap;
+} tb_ini_edit;
+
+/* the buffer is not copied and has to outlive the edit */
+void tb_ini_edit_init(tb_ini_edit* edit, const char* ini, size_t len);
+void tb_ini_edit_destroy(tb_ini_edit* edit);
+
+/* sets the value of the property, the property (and its section) is added if it does not exist */
+tb_ini_error tb_ini_edit_set(tb_ini_edit* edit, const char* section, const char* prop, const char* value);
+
+/* removes the line of the property, returns TB_INI_BAD_PROPERTY if it does not exist */
+tb_ini_error tb_ini_edit_remove(tb_ini_edit* edit, const char* section, const char* prop);
+
+/* adds an empty section if it does not exist */
+tb_ini_error tb_ini_edit_add_section(tb_ini_edit* edit, const char* section);
+
+/* size of the edited text */
+size_t tb_ini_edit_size(const tb_ini_edit* edit);
+
+/* copies the edited text into dst (zero terminated, copies at most dst_len bytes) and returns its length */
+size_t tb_ini_edit_render(const tb_ini_edit* edit, char* dst, size_t dst_len);
+
+/*
+ * writes the edited text to a temporary file next to path which then replaces the file,
+ * so readers (and file watchers) never see a partially written file
+ */
+tb_ini_error tb_ini_edit_save(const tb_ini_edit* edit, const char* path);
+
+#endif /* !TB_INI_EDIT_H */
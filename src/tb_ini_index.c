@@ -0,0 +1,798 @@
+#include "tb_ini_index.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define TB_INI_PTHREADS
+#endif
+
+/* per-chunk tables use pointers into the buffer and are converted to offsets when merged */
+typedef struct
+{
+    const char* name;
+    size_t name_len;
+    const char* start;
+    const char* end;
+    size_t first_prop;  /* holds the position in file order until the chunk is sorted */
+    size_t prop_count;
+} tb_ini_chunk_section;
+
+typedef struct
+{
+    const char* name;
+    size_t name_len;
+    const char* value;
+    size_t value_len;
+    tb_ini_error error;
+    size_t section;
+} tb_ini_chunk_prop;
+
+typedef struct
+{
+    const char* ini;
+    size_t begin;
+    size_t end;
+
+    tb_ini_chunk_section* sections;
+    size_t section_count;
+    size_t section_cap;
+
+    tb_ini_chunk_prop* props;
+    size_t prop_count;
+    size_t prop_cap;
+
+    size_t current;     /* current section or SIZE_MAX before the first/after a malformed header */
+    tb_ini_error error;
+} tb_ini_index_chunk;
+
+static int tb_ini_index_cmp_name(const char* name, size_t len, const char* str, size_t str_len)
+{
+    int cmp = memcmp(name, str, len < str_len ? len : str_len);
+    return cmp ? cmp : (len > str_len) - (len < str_len);
+}
+
+static void* tb_ini_index_grow(void* buf, size_t* cap, size_t count, size_t elem_size)
+{
+    if (count < *cap) return buf;
+
+    size_t new_cap = *cap ? *cap * 2 : 64;
+    void* grown = realloc(buf, new_cap * elem_size);
+    if (grown) *cap = new_cap;
+    return grown;
+}
+
+/* ----------------------------| Chunk indexing |--------------------------------------------------- */
+static int tb_ini_index_push_section(tb_ini_index_chunk* chunk, const char* name, size_t name_len, const char* start)
+{
+    tb_ini_chunk_section* sections = tb_ini_index_grow(chunk->sections, &chunk->section_cap, chunk->section_count, sizeof(tb_ini_chunk_section));
+    if (!sections)
+    {
+        chunk->error = TB_INI_ALLOC_ERROR;
+        return 1;
+    }
+
+    chunk->sections = sections;
+    chunk->current = chunk->section_count++;
+
+    tb_ini_chunk_section* section = &chunk->sections[chunk->current];
+    section->name = name;
+    section->name_len = name_len;
+    section->start = start;
+    section->end = start;
+    section->first_prop = chunk->current;
+    section->prop_count = 0;
+    return 0;
+}
+
+/* the open section ends at the '[' of the next header */
+static void tb_ini_index_close_section(tb_ini_index_chunk* chunk, const char* end)
+{
+    if (chunk->current != SIZE_MAX) chunk->sections[chunk->current].end = end;
+}
+
+static int tb_ini_index_on_section(void* user, const tb_ini_element* section)
+{
+    tb_ini_index_chunk* chunk = user;
+    tb_ini_index_close_section(chunk, (section->error == TB_INI_OK) ? section->name - 1 : section->start);
+
+    if (section->error != TB_INI_OK)
+    {
+        chunk->current = SIZE_MAX;
+        return 0;
+    }
+    return tb_ini_index_push_section(chunk, section->name, section->name_len, section->start);
+}
+
+static int tb_ini_index_on_property(void* user, const tb_ini_element* section, const tb_ini_element* element)
+{
+    tb_ini_index_chunk* chunk = user;
+    (void)section;
+
+    /* lines without a key value pair and properties of malformed sections are not indexed */
+    if (chunk->current == SIZE_MAX || element->error == TB_INI_BAD_PROPERTY) return 0;
+
+    tb_ini_chunk_prop* props = tb_ini_index_grow(chunk->props, &chunk->prop_cap, chunk->prop_count, sizeof(tb_ini_chunk_prop));
+    if (!props)
+    {
+        chunk->error = TB_INI_ALLOC_ERROR;
+        return 1;
+    }
+    chunk->props = props;
+
+    tb_ini_chunk_prop* prop = &chunk->props[chunk->prop_count++];
+    prop->name = element->name;
+    prop->name_len = element->name_len;
+    prop->value = element->start ? element->start : element->name;
+    prop->value_len = element->len;
+    prop->error = element->error;
+    prop->section = chunk->current;
+    return 0;
+}
+
+/* names are compared first, equal names are ordered by their position in the file */
+static int tb_ini_index_section_cmp(const void* left, const void* right)
+{
+    const tb_ini_chunk_section* l = left;
+    const tb_ini_chunk_section* r = right;
+
+    int cmp = tb_ini_index_cmp_name(l->name, l->name_len, r->name, r->name_len);
+    return cmp ? cmp : (l->name > r->name) - (l->name < r->name);
+}
+
+static int tb_ini_index_prop_cmp(const void* left, const void* right)
+{
+    const tb_ini_chunk_prop* l = left;
+    const tb_ini_chunk_prop* r = right;
+
+    if (l->section != r->section) return (l->section > r->section) - (l->section < r->section);
+
+    int cmp = tb_ini_index_cmp_name(l->name, l->name_len, r->name, r->name_len);
+    return cmp ? cmp : (l->name > r->name) - (l->name < r->name);
+}
+
+/* sorts the tables of the chunk and drops duplicate sections and properties (the first one wins) */
+static tb_ini_error tb_ini_index_sort_chunk(tb_ini_index_chunk* chunk)
+{
+    size_t* map = malloc((chunk->section_count + 1) * sizeof(size_t));
+    if (!map) return TB_INI_ALLOC_ERROR;
+
+    if (chunk->section_count > 1) qsort(chunk->sections, chunk->section_count, sizeof(tb_ini_chunk_section), tb_ini_index_section_cmp);
+
+    size_t section_count = 0;
+    for (size_t i = 0; i < chunk->section_count; ++i)
+    {
+        tb_ini_chunk_section* section = &chunk->sections[i];
+        tb_ini_chunk_section* prev = section_count ? &chunk->sections[section_count - 1] : NULL;
+        int duplicate = prev && tb_ini_index_cmp_name(prev->name, prev->name_len, section->name, section->name_len) == 0;
+
+        map[section->first_prop] = duplicate ? SIZE_MAX : section_count;
+        if (!duplicate)
+        {
+            section->first_prop = 0;
+            chunk->sections[section_count++] = *section;
+        }
+    }
+    chunk->section_count = section_count;
+
+    size_t prop_count = 0;
+    for (size_t i = 0; i < chunk->prop_count; ++i)
+    {
+        tb_ini_chunk_prop prop = chunk->props[i];
+        prop.section = map[prop.section];
+        if (prop.section != SIZE_MAX) chunk->props[prop_count++] = prop;
+    }
+    free(map);
+
+    if (prop_count > 1) qsort(chunk->props, prop_count, sizeof(tb_ini_chunk_prop), tb_ini_index_prop_cmp);
+
+    size_t unique = 0;
+    for (size_t i = 0; i < prop_count; ++i)
+    {
+        tb_ini_chunk_prop* prop = &chunk->props[i];
+        tb_ini_chunk_prop* prev = unique ? &chunk->props[unique - 1] : NULL;
+        if (prev && prev->section == prop->section && tb_ini_index_cmp_name(prev->name, prev->name_len, prop->name, prop->name_len) == 0) continue;
+
+        tb_ini_chunk_section* section = &chunk->sections[prop->section];
+        if (section->prop_count++ == 0) section->first_prop = unique;
+
+        chunk->props[unique++] = *prop;
+    }
+    chunk->prop_count = unique;
+
+    return TB_INI_OK;
+}
+
+/* collects the sections of the chunk and its properties if property is not NULL */
+static void tb_ini_index_scan(tb_ini_index_chunk* chunk, tb_ini_property_func property)
+{
+    /* the properties before the first section belong to the unnamed root section of the first chunk */
+    if (chunk->begin == 0 && tb_ini_index_push_section(chunk, chunk->ini, 0, chunk->ini) != 0) return;
+
+    tb_ini_handler handler = { tb_ini_index_on_section, property, chunk };
+    tb_ini_walk_n(chunk->ini + chunk->begin, chunk->end - chunk->begin, &handler);
+    tb_ini_index_close_section(chunk, chunk->ini + chunk->end);
+
+    if (chunk->error == TB_INI_OK) chunk->error = tb_ini_index_sort_chunk(chunk);
+}
+
+static void tb_ini_index_chunk_task(void* arg, size_t index)
+{
+    tb_ini_index_scan((tb_ini_index_chunk*)arg + index, tb_ini_index_on_property);
+}
+
+/* returns the start of the first line after pos that starts with '[' or len */
+static size_t tb_ini_index_split(const char* ini, size_t len, size_t pos)
+{
+    while (pos < len)
+    {
+        const char* line_end = memchr(ini + pos, '\n', len - pos);
+        if (!line_end) return len;
+
+        pos = line_end - ini + 1;
+        if (pos < len && ini[pos] == '[') return pos;
+    }
+    return len;
+}
+
+/* ----------------------------| Merge |------------------------------------------------------------ */
+/* merges the sorted chunk tables, for sections in multiple chunks the one in the earliest chunk wins */
+static tb_ini_error tb_ini_index_merge(tb_ini_index* index, tb_ini_index_chunk* chunks, size_t count)
+{
+    size_t section_count = 0;
+    size_t prop_count = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        section_count += chunks[i].section_count;
+        prop_count += chunks[i].prop_count;
+    }
+
+    size_t* heads = calloc(count, sizeof(size_t));
+    index->sections = malloc((section_count + 1) * sizeof(tb_ini_index_section));
+    index->props = malloc((prop_count + 1) * sizeof(tb_ini_index_prop));
+
+    if (!heads || !index->sections || !index->props)
+    {
+        free(heads);
+        return TB_INI_ALLOC_ERROR;
+    }
+
+    const char* ini = index->ini;
+    while (1)
+    {
+        /* find the smallest section name at the heads of the chunks */
+        tb_ini_index_chunk* min = NULL;
+        tb_ini_chunk_section* min_section = NULL;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (heads[i] >= chunks[i].section_count) continue;
+
+            tb_ini_chunk_section* section = &chunks[i].sections[heads[i]];
+            if (!min_section || tb_ini_index_cmp_name(section->name, section->name_len, min_section->name, min_section->name_len) < 0)
+            {
+                min = &chunks[i];
+                min_section = section;
+            }
+        }
+
+        if (!min) break;
+
+        /* skip the same section in later chunks */
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (&chunks[i] == min || heads[i] >= chunks[i].section_count) continue;
+
+            tb_ini_chunk_section* section = &chunks[i].sections[heads[i]];
+            if (tb_ini_index_cmp_name(section->name, section->name_len, min_section->name, min_section->name_len) == 0) heads[i]++;
+        }
+
+        tb_ini_index_section* section = &index->sections[index->section_count];
+        section->name = min_section->name - ini;
+        section->name_len = min_section->name_len;
+        section->start = min_section->start - ini;
+        section->end = min_section->end - ini;
+        section->first_prop = index->prop_count;
+        section->prop_count = min_section->prop_count;
+
+        for (size_t i = 0; i < min_section->prop_count; ++i)
+        {
+            tb_ini_chunk_prop* src = &min->props[min_section->first_prop + i];
+            tb_ini_index_prop* prop = &index->props[index->prop_count++];
+
+            prop->name = src->name - ini;
+            prop->name_len = src->name_len;
+            prop->value = src->value - ini;
+            prop->value_len = src->value_len;
+            prop->error = src->error;
+            prop->section = index->section_count;
+        }
+
+        index->section_count++;
+        heads[min - chunks]++;
+    }
+
+    free(heads);
+    return TB_INI_OK;
+}
+
+/* ----------------------------| Incremental update |---------------------------------------------- */
+static void tb_ini_index_section_element(const tb_ini_index* index, const tb_ini_index_section* section, tb_ini_element* element)
+{
+    element->name = index->ini + section->name;
+    element->name_len = section->name_len;
+    element->start = index->ini + section->start;
+    element->len = section->prop_count;
+    element->error = TB_INI_OK;
+}
+
+static void tb_ini_index_prop_element(const tb_ini_index* index, const tb_ini_index_prop* prop, tb_ini_element* element)
+{
+    element->name = index->ini + prop->name;
+    element->name_len = prop->name_len;
+    element->start = index->ini + prop->value;
+    element->len = prop->value_len;
+    element->error = prop->error;
+}
+
+/* compares the bytes after the header lines, sections with the same name and bytes have the same properties */
+static int tb_ini_index_section_equal(const char* ini, const tb_ini_index_section* section, const char* start, size_t len)
+{
+    return section->end - section->start == len && memcmp(ini + section->start, start, len) == 0;
+}
+
+static tb_ini_error tb_ini_index_reserve_props(tb_ini_index* index, size_t* cap, size_t count)
+{
+    while (index->prop_count + count > *cap)
+    {
+        tb_ini_index_prop* props = tb_ini_index_grow(index->props, cap, *cap, sizeof(tb_ini_index_prop));
+        if (!props) return TB_INI_ALLOC_ERROR;
+
+        index->props = props;
+    }
+    return TB_INI_OK;
+}
+
+/* parses the properties of a changed section and appends them to the index */
+static tb_ini_error tb_ini_index_parse_section(tb_ini_index* index, size_t* cap, const tb_ini_chunk_section* span, tb_ini_index_chunk* scratch)
+{
+    scratch->section_count = 0;
+    scratch->prop_count = 0;
+    scratch->error = TB_INI_OK;
+
+    /* the span does not contain any headers, so all properties belong to it */
+    if (tb_ini_index_push_section(scratch, span->name, span->name_len, span->start) != 0) return scratch->error;
+
+    tb_ini_handler handler = { NULL, tb_ini_index_on_property, scratch };
+    tb_ini_walk_n(span->start, span->end - span->start, &handler);
+
+    if (scratch->error == TB_INI_OK) scratch->error = tb_ini_index_sort_chunk(scratch);
+    if (scratch->error == TB_INI_OK) scratch->error = tb_ini_index_reserve_props(index, cap, scratch->prop_count);
+    if (scratch->error != TB_INI_OK) return scratch->error;
+
+    for (size_t i = 0; i < scratch->prop_count; ++i)
+    {
+        tb_ini_chunk_prop* src = &scratch->props[i];
+        tb_ini_index_prop* prop = &index->props[index->prop_count++];
+
+        prop->name = src->name - index->ini;
+        prop->name_len = src->name_len;
+        prop->value = src->value - index->ini;
+        prop->value_len = src->value_len;
+        prop->error = src->error;
+        prop->section = index->section_count;
+    }
+    return TB_INI_OK;
+}
+
+/* copies the properties of an unchanged section, they only moved by the difference of the section starts */
+static tb_ini_error tb_ini_index_copy_section(tb_ini_index* index, size_t* cap, const tb_ini_index* prev, const tb_ini_index_section* old, size_t start)
+{
+    if (tb_ini_index_reserve_props(index, cap, old->prop_count) != TB_INI_OK) return TB_INI_ALLOC_ERROR;
+
+    for (size_t i = 0; i < old->prop_count; ++i)
+    {
+        tb_ini_index_prop* prop = &index->props[index->prop_count++];
+        *prop = prev->props[old->first_prop + i];
+
+        prop->name = prop->name - old->start + start;
+        prop->value = prop->value - old->start + start;
+        prop->section = index->section_count;
+    }
+    return TB_INI_OK;
+}
+
+static size_t tb_ini_index_report_section(const tb_ini_index* index, const tb_ini_index_section* section, tb_ini_change change, tb_ini_change_func func, void* user)
+{
+    if (!func) return section->prop_count + 1;
+
+    tb_ini_element element, prop;
+    tb_ini_index_section_element(index, section, &element);
+
+    func(user, change, &element, NULL);
+    for (size_t i = 0; i < section->prop_count; ++i)
+    {
+        tb_ini_index_prop_element(index, &index->props[section->first_prop + i], &prop);
+        func(user, change, &element, &prop);
+    }
+    return section->prop_count + 1;
+}
+
+static size_t tb_ini_index_diff_section(const tb_ini_index* prev, const tb_ini_index_section* old, const tb_ini_index* index, const tb_ini_index_section* section, tb_ini_change_func func, void* user)
+{
+    tb_ini_element old_element, element, prop;
+    tb_ini_index_section_element(prev, old, &old_element);
+    tb_ini_index_section_element(index, section, &element);
+
+    size_t changes = 0;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < old->prop_count || j < section->prop_count)
+    {
+        const tb_ini_index_prop* l = (i < old->prop_count) ? &prev->props[old->first_prop + i] : NULL;
+        const tb_ini_index_prop* r = (j < section->prop_count) ? &index->props[section->first_prop + j] : NULL;
+
+        int cmp = !l ? 1 : !r ? -1 : tb_ini_index_cmp_name(prev->ini + l->name, l->name_len, index->ini + r->name, r->name_len);
+
+        tb_ini_change change = TB_INI_CHANGE_MODIFIED;
+        if (cmp < 0)
+        {
+            change = TB_INI_CHANGE_REMOVED;
+            i++;
+        }
+        else if (cmp > 0)
+        {
+            change = TB_INI_CHANGE_ADDED;
+            j++;
+        }
+        else
+        {
+            i++;
+            j++;
+            if (l->error == r->error && l->value_len == r->value_len && memcmp(prev->ini + l->value, index->ini + r->value, r->value_len) == 0) continue;
+        }
+
+        changes++;
+        if (!func) continue;
+
+        if (change == TB_INI_CHANGE_REMOVED)
+        {
+            tb_ini_index_prop_element(prev, l, &prop);
+            func(user, change, &old_element, &prop);
+        }
+        else
+        {
+            tb_ini_index_prop_element(index, r, &prop);
+            func(user, change, &element, &prop);
+        }
+    }
+    return changes;
+}
+
+/* ----------------------------| Public API |------------------------------------------------------- */
+tb_ini_error tb_ini_index_build(tb_ini_index* index, const char* ini, size_t len, size_t chunks, tb_ini_run_func run, void* pool)
+{
+    memset(index, 0, sizeof(tb_ini_index));
+    index->ini = ini;
+    index->len = len;
+
+    if (chunks == 0) chunks = 1;
+
+    tb_ini_index_chunk* parts = calloc(chunks, sizeof(tb_ini_index_chunk));
+    if (!parts) return TB_INI_ALLOC_ERROR;
+
+    /* split at the first section header after every (len / chunks) bytes */
+    size_t count = 0;
+    size_t begin = 0;
+    while (begin < len || count == 0)
+    {
+        size_t end = (count + 1 < chunks) ? tb_ini_index_split(ini, len, begin + len / chunks) : len;
+
+        parts[count].ini = ini;
+        parts[count].begin = begin;
+        parts[count].end = end;
+        parts[count].current = SIZE_MAX;
+        parts[count].error = TB_INI_OK;
+
+        count++;
+        begin = end;
+    }
+
+    if (run)    run(pool, tb_ini_index_chunk_task, parts, count);
+    else        for (size_t i = 0; i < count; ++i) tb_ini_index_chunk_task(parts, i);
+
+    tb_ini_error error = TB_INI_OK;
+    for (size_t i = 0; i < count && error == TB_INI_OK; ++i)
+        error = parts[i].error;
+
+    if (error == TB_INI_OK) error = tb_ini_index_merge(index, parts, count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        free(parts[i].sections);
+        free(parts[i].props);
+    }
+    free(parts);
+
+    if (error != TB_INI_OK) tb_ini_index_destroy(index);
+    return error;
+}
+
+void tb_ini_index_destroy(tb_ini_index* index)
+{
+    free(index->sections);
+    free(index->props);
+
+    index->sections = NULL;
+    index->section_count = 0;
+    index->props = NULL;
+    index->prop_count = 0;
+}
+
+tb_ini_error tb_ini_index_update(tb_ini_index* index, const tb_ini_index* prev, const char* ini, size_t len)
+{
+    if (!prev) return tb_ini_index_build(index, ini, len, 1, NULL, NULL);
+
+    memset(index, 0, sizeof(tb_ini_index));
+    index->ini = ini;
+    index->len = len;
+
+    /* find the sections of the new buffer without collecting their properties */
+    tb_ini_index_chunk spans = { ini, 0, len, NULL, 0, 0, NULL, 0, 0, SIZE_MAX, TB_INI_OK };
+    tb_ini_index_chunk scratch = { ini, 0, 0, NULL, 0, 0, NULL, 0, 0, SIZE_MAX, TB_INI_OK };
+    tb_ini_index_scan(&spans, NULL);
+
+    tb_ini_error error = spans.error;
+    size_t cap = prev->prop_count + 1;
+    if (error == TB_INI_OK)
+    {
+        index->sections = malloc((spans.section_count + 1) * sizeof(tb_ini_index_section));
+        index->props = malloc(cap * sizeof(tb_ini_index_prop));
+        if (!index->sections || !index->props) error = TB_INI_ALLOC_ERROR;
+    }
+
+    /* both section tables are sorted by name, so the previous versions are found by merging them */
+    size_t j = 0;
+    for (size_t i = 0; i < spans.section_count && error == TB_INI_OK; ++i)
+    {
+        const tb_ini_chunk_section* span = &spans.sections[i];
+        const tb_ini_index_section* old = NULL;
+
+        for (; j < prev->section_count; ++j)
+        {
+            const tb_ini_index_section* section = &prev->sections[j];
+            int cmp = tb_ini_index_cmp_name(prev->ini + section->name, section->name_len, span->name, span->name_len);
+
+            if (cmp > 0) break;
+            if (cmp == 0)
+            {
+                old = section;
+                break;
+            }
+        }
+
+        tb_ini_index_section* section = &index->sections[index->section_count];
+        section->name = span->name - ini;
+        section->name_len = span->name_len;
+        section->start = span->start - ini;
+        section->end = span->end - ini;
+        section->first_prop = index->prop_count;
+
+        if (old && tb_ini_index_section_equal(prev->ini, old, span->start, span->end - span->start))
+            error = tb_ini_index_copy_section(index, &cap, prev, old, section->start);
+        else
+            error = tb_ini_index_parse_section(index, &cap, span, &scratch);
+
+        section->prop_count = index->prop_count - section->first_prop;
+        index->section_count++;
+    }
+
+    free(spans.sections);
+    free(spans.props);
+    free(scratch.sections);
+    free(scratch.props);
+
+    if (error != TB_INI_OK) tb_ini_index_destroy(index);
+    return error;
+}
+
+size_t tb_ini_index_diff(const tb_ini_index* prev, const tb_ini_index* index, tb_ini_change_func func, void* user)
+{
+    size_t changes = 0;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < prev->section_count || j < index->section_count)
+    {
+        const tb_ini_index_section* old = (i < prev->section_count) ? &prev->sections[i] : NULL;
+        const tb_ini_index_section* section = (j < index->section_count) ? &index->sections[j] : NULL;
+
+        int cmp = !old ? 1 : !section ? -1 : tb_ini_index_cmp_name(prev->ini + old->name, old->name_len, index->ini + section->name, section->name_len);
+
+        if (cmp < 0)
+        {
+            changes += tb_ini_index_report_section(prev, old, TB_INI_CHANGE_REMOVED, func, user);
+            i++;
+        }
+        else if (cmp > 0)
+        {
+            changes += tb_ini_index_report_section(index, section, TB_INI_CHANGE_ADDED, func, user);
+            j++;
+        }
+        else
+        {
+            if (!tb_ini_index_section_equal(prev->ini, old, index->ini + section->start, section->end - section->start))
+                changes += tb_ini_index_diff_section(prev, old, index, section, func, user);
+            i++;
+            j++;
+        }
+    }
+    return changes;
+}
+
+#ifdef TB_INI_PTHREADS
+typedef struct
+{
+    tb_ini_task_func task;
+    void* arg;
+    size_t index;
+} tb_ini_thread_task;
+
+static void* tb_ini_thread_main(void* arg)
+{
+    tb_ini_thread_task* task = arg;
+    task->task(task->arg, task->index);
+    return NULL;
+}
+#endif
+
+void tb_ini_run_threads(void* pool, tb_ini_task_func task, void* arg, size_t count)
+{
+    (void)pool;
+
+#ifdef TB_INI_PTHREADS
+    pthread_t* threads = malloc(count * sizeof(pthread_t));
+    tb_ini_thread_task* tasks = malloc(count * sizeof(tb_ini_thread_task));
+    int* started = calloc(count, sizeof(int));
+
+    if (threads && tasks && started)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            tasks[i].task = task;
+            tasks[i].arg = arg;
+            tasks[i].index = i;
+            started[i] = pthread_create(&threads[i], NULL, tb_ini_thread_main, &tasks[i]) == 0;
+
+            /* run the task on this thread if no thread could be started */
+            if (!started[i]) task(arg, i);
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            if (started[i]) pthread_join(threads[i], NULL);
+
+        free(threads);
+        free(tasks);
+        free(started);
+        return;
+    }
+
+    free(threads);
+    free(tasks);
+    free(started);
+#endif
+    for (size_t i = 0; i < count; ++i) task(arg, i);
+}
+
+static const tb_ini_index_section* tb_ini_index_find_section(const tb_ini_index* index, const char* name)
+{
+    if (!name) name = "";
+    size_t len = strlen(name);
+
+    size_t first = 0;
+    size_t last = index->section_count;
+    while (first < last)
+    {
+        size_t mid = first + (last - first) / 2;
+        const tb_ini_index_section* section = &index->sections[mid];
+
+        int cmp = tb_ini_index_cmp_name(index->ini + section->name, section->name_len, name, len);
+        if (cmp == 0) return section;
+
+        if (cmp < 0)    first = mid + 1;
+        else            last = mid;
+    }
+    return NULL;
+}
+
+static const tb_ini_index_prop* tb_ini_index_find_prop(const tb_ini_index* index, const tb_ini_index_section* section, const char* name)
+{
+    size_t len = strlen(name);
+
+    size_t first = section->first_prop;
+    size_t last = first + section->prop_count;
+    while (first < last)
+    {
+        size_t mid = first + (last - first) / 2;
+        const tb_ini_index_prop* prop = &index->props[mid];
+
+        int cmp = tb_ini_index_cmp_name(index->ini + prop->name, prop->name_len, name, len);
+        if (cmp == 0) return prop;
+
+        if (cmp < 0)    first = mid + 1;
+        else            last = mid;
+    }
+    return NULL;
+}
+
+tb_ini_error tb_ini_index_query(const tb_ini_index* index, const char* section, const char* prop, tb_ini_element* element)
+{
+    element->name = NULL;
+    element->name_len = 0;
+    element->start = NULL;
+    element->len = 0;
+
+    const tb_ini_index_section* s = tb_ini_index_find_section(index, section);
+    if (!s) return element->error = TB_INI_BAD_SECTION;
+
+    if (!prop)
+    {
+        tb_ini_index_section_element(index, s, element);
+        return element->error;
+    }
+
+    const tb_ini_index_prop* p = tb_ini_index_find_prop(index, s, prop);
+    if (!p) return element->error = TB_INI_BAD_PROPERTY;
+
+    tb_ini_index_prop_element(index, p, element);
+    return element->error;
+}
+
+int tb_ini_index_bool(const tb_ini_index* index, const char* section, const char* prop, int def)
+{
+    tb_ini_element element;
+    return (tb_ini_index_query(index, section, prop, &element) == TB_INI_OK) ? tb_ini_element_to_bool(&element) : def;
+}
+
+int tb_ini_index_int(const tb_ini_index* index, const char* section, const char* prop, int def)
+{
+    int64_t value = tb_ini_index_int64(index, section, prop, def);
+    return (value >= INT_MIN && value <= INT_MAX) ? (int)value : def;
+}
+
+int64_t tb_ini_index_int64(const tb_ini_index* index, const char* section, const char* prop, int64_t def)
+{
+    tb_ini_element element;
+    int64_t value;
+    if (tb_ini_index_query(index, section, prop, &element) != TB_INI_OK) return def;
+
+    return (tb_ini_element_to_int64(&element, &value) == TB_INI_OK) ? value : def;
+}
+
+float tb_ini_index_float(const tb_ini_index* index, const char* section, const char* prop, float def)
+{
+    double d = tb_ini_index_double(index, section, prop, def);
+
+    /* finite values beyond the range of float are out of range, like in tb_ini_float */
+    return (!isinf(d) && (d > FLT_MAX || d < -FLT_MAX)) ? def : (float)d;
+}
+
+double tb_ini_index_double(const tb_ini_index* index, const char* section, const char* prop, double def)
+{
+    tb_ini_element element;
+    double value;
+    if (tb_ini_index_query(index, section, prop, &element) != TB_INI_OK) return def;
+
+    return (tb_ini_element_to_double(&element, &value) == TB_INI_OK) ? value : def;
+}
+
+size_t tb_ini_index_string(const tb_ini_index* index, const char* section, const char* prop, char* dst, size_t dst_len)
+{
+    tb_ini_element element;
+    if (tb_ini_index_query(index, section, prop, &element) == TB_INI_OK) return tb_ini_element_to_string(&element, dst, dst_len);
+
+    dst[0] = '\0';
+    return 0;
+}
@@ -0,0 +1,107 @@
+#ifndef TB_INI_INDEX_H
+#define TB_INI_INDEX_H
+
+#include "tb_ini.h"
+
+/*
+ * Sorted section and property tables pointing into an ini buffer.
+ * Building the index parses the buffer once, queries are binary searches afterwards.
+ * The buffer is not copied and has to outlive the index.
+ *
+ * For large buffers the index can be built in parallel: the buffer is split into chunks at
+ * lines starting with '[', every chunk is indexed by its own task and the per-chunk tables are
+ * merged. As with tb_ini_query the first occurrence of a section or property wins, so the result
+ * is the same as building with a single chunk (lines inside multi-line {} values must not start
+ * with '[' for this to hold). A NULL section refers to the properties before the first section.
+ */
+typedef void (*tb_ini_task_func)(void* arg, size_t index);
+
+/* runs task(arg, i) for i in [0, count) and returns once all of them are done */
+typedef void (*tb_ini_run_func)(void* pool, tb_ini_task_func task, void* arg, size_t count);
+
+typedef struct
+{
+    size_t name;        /* offset of the name */
+    size_t name_len;
+    size_t start;       /* offset of the end of the header line */
+    size_t end;         /* offset of the next section header (or the end of the buffer) */
+    size_t first_prop;
+    size_t prop_count;
+} tb_ini_index_section;
+
+typedef struct
+{
+    size_t name;        /* offset of the name */
+    size_t name_len;
+    size_t value;       /* offset of the value */
+    size_t value_len;
+    tb_ini_error error;
+    size_t section;
+} tb_ini_index_prop;
+
+typedef struct
+{
+    const char* ini;
+    size_t len;
+
+    tb_ini_index_section* sections;
+    size_t section_count;
+
+    tb_ini_index_prop* props;
+    size_t prop_count;
+} tb_ini_index;
+
+/*
+ * Builds the index of the buffer split into (at most) chunks parts.
+ * run is used to execute the per-chunk tasks; if it is NULL they run on the calling thread.
+ * tb_ini_run_threads can be used if no thread pool is at hand (pool is ignored).
+ */
+tb_ini_error tb_ini_index_build(tb_ini_index* index, const char* ini, size_t len, size_t chunks, tb_ini_run_func run, void* pool);
+void tb_ini_index_destroy(tb_ini_index* index);
+
+/*
+ * Builds the index of a changed buffer from the index of its previous version.
+ * Sections are compared byte-wise with their previous version and only the ones that
+ * changed are parsed again, the properties of all others are taken from prev.
+ * The result is the same as building the index from scratch, prev stays untouched.
+ */
+tb_ini_error tb_ini_index_update(tb_ini_index* index, const tb_ini_index* prev, const char* ini, size_t len);
+
+typedef enum
+{
+    TB_INI_CHANGE_ADDED,
+    TB_INI_CHANGE_REMOVED,
+    TB_INI_CHANGE_MODIFIED
+} tb_ini_change;
+
+/*
+ * called for every changed property, prop is NULL if the section itself was added or removed
+ * elements of removed sections and properties point into the old buffer, all others into the new one
+ */
+typedef void (*tb_ini_change_func)(void* user, tb_ini_change change, const tb_ini_element* section, const tb_ini_element* prop);
+
+/*
+ * Reports the differences between two indices (usually of two versions of the same file).
+ * Sections with unchanged bytes are skipped without looking at their properties.
+ * Returns the number of reported changes.
+ */
+size_t tb_ini_index_diff(const tb_ini_index* prev, const tb_ini_index* index, tb_ini_change_func func, void* user);
+
+/* starts one thread per task (POSIX threads), falls back to running the tasks in order elsewhere */
+void tb_ini_run_threads(void* pool, tb_ini_task_func task, void* arg, size_t count);
+
+/*
+ * Works like tb_ini_query, the element points into the indexed buffer.
+ * If prop is NULL the section is returned with len being the number of properties.
+ */
+tb_ini_error tb_ini_index_query(const tb_ini_index* index, const char* section, const char* prop, tb_ini_element* element);
+
+/* utility functions to directly convert query to different types */
+int     tb_ini_index_bool(const tb_ini_index* index, const char* section, const char* prop, int def);
+int     tb_ini_index_int(const tb_ini_index* index, const char* section, const char* prop, int def);
+int64_t tb_ini_index_int64(const tb_ini_index* index, const char* section, const char* prop, int64_t def);
+float   tb_ini_index_float(const tb_ini_index* index, const char* section, const char* prop, float def);
+double  tb_ini_index_double(const tb_ini_index* index, const char* section, const char* prop, double def);
+size_t  tb_ini_index_string(const tb_ini_index* index, const char* section, const char* prop, char* dst, size_t dst_len);
+
+#endif /* !TB_INI_INDEX_H */
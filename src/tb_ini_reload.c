@@ -0,0 +1,334 @@
+#include "tb_ini_reload.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#define TB_INI_INOTIFY
+#endif
+
+/* reader counters are kept on separate cache lines */
+typedef struct
+{
+    atomic_size_t count;
+    char pad[64 - sizeof(atomic_size_t)];
+} tb_ini_reload_counter;
+
+struct tb_ini_reload
+{
+    _Atomic(tb_ini_config*) current;
+
+    /*
+     * readers increment the counter of the current epoch before loading current, after a swap
+     * the epoch is flipped twice and each time the previous counter is waited on to drain
+     */
+    atomic_uint epoch;
+    tb_ini_reload_counter readers[2];
+
+    char* path;
+    size_t chunks;
+    tb_ini_reload_func func;
+    void* user;
+
+    pthread_mutex_t mutex;      /* serializes reloads, never taken by readers */
+    pthread_t thread;
+    int wake[2];                /* pipe written to by close to stop the watcher */
+};
+
+/* ----------------------------| Loading |---------------------------------------------------------- */
+static uint64_t tb_ini_reload_mtime(const char* path)
+{
+    struct stat st;
+    return (stat(path, &st) == 0) ? (uint64_t)st.st_mtime : 0;
+}
+
+static void tb_ini_config_free(tb_ini_config* config)
+{
+    if (!config) return;
+
+    tb_ini_index_destroy(&config->index);
+    free(config->ini);
+    free(config);
+}
+
+/* loads the file, if prev is not NULL only the sections that changed since then are parsed */
+static tb_ini_config* tb_ini_config_load(const char* path, size_t chunks, const tb_ini_config* prev, tb_ini_error* error)
+{
+    tb_ini_config* config = calloc(1, sizeof(tb_ini_config));
+    if (!config)
+    {
+        *error = TB_INI_ALLOC_ERROR;
+        return NULL;
+    }
+
+    config->mtime = tb_ini_reload_mtime(path);
+
+    FILE* file = fopen(path, "rb");
+    long size = -1;
+    if (file && fseek(file, 0, SEEK_END) == 0) size = ftell(file);
+
+    *error = TB_INI_IO_ERROR;
+    if (size >= 0 && fseek(file, 0, SEEK_SET) == 0)
+    {
+        config->ini = malloc((size_t)size + 1);
+        *error = TB_INI_ALLOC_ERROR;
+
+        if (config->ini)
+        {
+            config->len = fread(config->ini, 1, (size_t)size, file);
+            config->ini[config->len] = '\0';
+
+            if (config->len != (size_t)size)    *error = TB_INI_IO_ERROR;
+            else if (prev)                      *error = tb_ini_index_update(&config->index, &prev->index, config->ini, config->len);
+            else                                *error = tb_ini_index_build(&config->index, config->ini, config->len, chunks, tb_ini_run_threads, NULL);
+        }
+    }
+
+    if (file) fclose(file);
+
+    if (*error != TB_INI_OK)
+    {
+        free(config->ini);
+        free(config);
+        return NULL;
+    }
+    return config;
+}
+
+/* ----------------------------| Publishing |------------------------------------------------------- */
+/* waits until no reader can hold a config that was replaced before this call */
+static void tb_ini_reload_synchronize(tb_ini_reload* reload)
+{
+    for (int i = 0; i < 2; ++i)
+    {
+        unsigned epoch = atomic_fetch_add(&reload->epoch, 1) & 1;
+        while (atomic_load(&reload->readers[epoch].count) != 0) sched_yield();
+    }
+}
+
+static tb_ini_error tb_ini_reload_publish(tb_ini_reload* reload)
+{
+    /* only the reloading thread replaces current, so it can be read without synchronization */
+    tb_ini_config* old = atomic_load_explicit(&reload->current, memory_order_relaxed);
+
+    tb_ini_error error;
+    tb_ini_config* config = tb_ini_config_load(reload->path, reload->chunks, old, &error);
+    if (!config) return error;
+
+    /* nothing to do if the content did not change */
+    if (old->len == config->len && memcmp(old->ini, config->ini, config->len) == 0)
+    {
+        tb_ini_config_free(config);
+        return TB_INI_OK;
+    }
+
+    config->version = old->version + 1;
+    atomic_store(&reload->current, config);
+
+    if (reload->func) reload->func(reload->user, old, config);
+
+    tb_ini_reload_synchronize(reload);
+    tb_ini_config_free(old);
+
+    return TB_INI_OK;
+}
+
+/* ----------------------------| Watcher |---------------------------------------------------------- */
+#ifdef TB_INI_INOTIFY
+/* watches the directory since editors often replace the file instead of writing to it */
+static int tb_ini_reload_watch(tb_ini_reload* reload, const char** name)
+{
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) return -1;
+
+    const char* sep = strrchr(reload->path, '/');
+    *name = sep ? sep + 1 : reload->path;
+
+    /* the root directory keeps its separator */
+    size_t dir_len = sep ? (size_t)(sep - reload->path) + (sep == reload->path) : 1;
+    char* dir = malloc(dir_len + 1);
+    if (dir)
+    {
+        memcpy(dir, sep ? reload->path : ".", dir_len);
+        dir[dir_len] = '\0';
+    }
+
+    int wd = dir ? inotify_add_watch(fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) : -1;
+    free(dir);
+
+    if (wd < 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* returns 1 if one of the pending events refers to the file */
+static int tb_ini_reload_changed(int fd, const char* name)
+{
+    union
+    {
+        struct inotify_event event;
+        char buf[4096];
+    } events;
+    int changed = 0;
+
+    ssize_t len;
+    while ((len = read(fd, events.buf, sizeof(events.buf))) > 0)
+    {
+        for (char* ptr = events.buf; ptr < events.buf + len; )
+        {
+            const struct inotify_event* event = (const struct inotify_event*)ptr;
+            if (event->len && strcmp(event->name, name) == 0) changed = 1;
+            ptr += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    return changed;
+}
+#endif
+
+static void* tb_ini_reload_main(void* arg)
+{
+    tb_ini_reload* reload = arg;
+
+    struct pollfd fds[2] = { { reload->wake[0], POLLIN, 0 }, { -1, POLLIN, 0 } };
+    int timeout = TB_INI_RELOAD_POLL_MS;
+    const char* name = NULL;
+
+#ifdef TB_INI_INOTIFY
+    fds[1].fd = tb_ini_reload_watch(reload, &name);
+    if (fds[1].fd >= 0) timeout = -1;
+#endif
+
+    uint64_t mtime = atomic_load(&reload->current)->mtime;
+    while (1)
+    {
+        int ready = poll(fds, (fds[1].fd >= 0) ? 2 : 1, timeout);
+        if (ready > 0 && (fds[0].revents & POLLIN)) break;
+
+        int changed = 0;
+#ifdef TB_INI_INOTIFY
+        if (fds[1].fd >= 0) changed = (fds[1].revents & POLLIN) && tb_ini_reload_changed(fds[1].fd, name);
+#endif
+        /* fall back to polling the modification time */
+        if (fds[1].fd < 0)
+        {
+            uint64_t current = tb_ini_reload_mtime(reload->path);
+            changed = (current != mtime);
+            mtime = current;
+        }
+
+        if (changed)
+        {
+            pthread_mutex_lock(&reload->mutex);
+            tb_ini_reload_publish(reload);
+            pthread_mutex_unlock(&reload->mutex);
+        }
+    }
+
+    if (fds[1].fd >= 0) close(fds[1].fd);
+    return NULL;
+}
+
+/* ----------------------------| Public API |------------------------------------------------------- */
+tb_ini_reload* tb_ini_reload_open(const char* path, size_t chunks, tb_ini_reload_func func, void* user, tb_ini_error* error)
+{
+    tb_ini_error err;
+    if (!error) error = &err;
+
+    tb_ini_reload* reload = calloc(1, sizeof(tb_ini_reload));
+    char* path_copy = malloc(strlen(path) + 1);
+    if (!reload || !path_copy)
+    {
+        free(reload);
+        free(path_copy);
+        *error = TB_INI_ALLOC_ERROR;
+        return NULL;
+    }
+
+    tb_ini_config* config = tb_ini_config_load(path, chunks, NULL, error);
+    if (!config)
+    {
+        free(reload);
+        free(path_copy);
+        return NULL;
+    }
+
+    config->version = 1;
+    atomic_init(&reload->current, config);
+    atomic_init(&reload->epoch, 0);
+    atomic_init(&reload->readers[0].count, 0);
+    atomic_init(&reload->readers[1].count, 0);
+
+    reload->path = strcpy(path_copy, path);
+    reload->chunks = chunks;
+    reload->func = func;
+    reload->user = user;
+
+    *error = TB_INI_UNKOWN_ERROR;
+    if (pthread_mutex_init(&reload->mutex, NULL) != 0) goto fail_mutex;
+    if (pipe(reload->wake) != 0) goto fail_pipe;
+    if (pthread_create(&reload->thread, NULL, tb_ini_reload_main, reload) != 0) goto fail_thread;
+
+    *error = TB_INI_OK;
+    return reload;
+
+fail_thread:
+    close(reload->wake[0]);
+    close(reload->wake[1]);
+fail_pipe:
+    pthread_mutex_destroy(&reload->mutex);
+fail_mutex:
+    tb_ini_config_free(config);
+    free(path_copy);
+    free(reload);
+    return NULL;
+}
+
+void tb_ini_reload_close(tb_ini_reload* reload)
+{
+    if (!reload) return;
+
+    /* wake the watcher, it stops after finishing a reload that might be in progress */
+    char stop = 1;
+    while (write(reload->wake[1], &stop, 1) != 1) sched_yield();
+    pthread_join(reload->thread, NULL);
+
+    close(reload->wake[0]);
+    close(reload->wake[1]);
+    pthread_mutex_destroy(&reload->mutex);
+
+    tb_ini_config_free(atomic_load(&reload->current));
+    free(reload->path);
+    free(reload);
+}
+
+const tb_ini_config* tb_ini_reload_acquire(tb_ini_reload* reload, unsigned* token)
+{
+    *token = atomic_load(&reload->epoch) & 1;
+    atomic_fetch_add(&reload->readers[*token].count, 1);
+
+    return atomic_load(&reload->current);
+}
+
+void tb_ini_reload_release(tb_ini_reload* reload, unsigned token)
+{
+    atomic_fetch_sub(&reload->readers[token & 1].count, 1);
+}
+
+tb_ini_error tb_ini_reload_refresh(tb_ini_reload* reload)
+{
+    pthread_mutex_lock(&reload->mutex);
+    tb_ini_error error = tb_ini_reload_publish(reload);
+    pthread_mutex_unlock(&reload->mutex);
+
+    return error;
+}
@@ -0,0 +1,58 @@
+#ifndef TB_INI_RELOAD_H
+#define TB_INI_RELOAD_H
+
+#include "tb_ini_index.h"
+
+/*
+ * Hot-reloadable ini configuration.
+ * The file is watched by a background thread (inotify on Linux, polling of the modification
+ * time elsewhere) and reparsed into a new immutable config whenever it changes. The new config
+ * is published with an atomic pointer swap, the old one is freed once the last reader that could
+ * have seen it released it. Readers never block and take no lock, only the reloading thread waits.
+ * Reloads use tb_ini_index_update, so only sections that changed are parsed again.
+ *
+ * Requires C11 atomics and POSIX threads.
+ */
+#define TB_INI_RELOAD_POLL_MS   500
+
+typedef struct
+{
+    char* ini;          /* zero terminated file content */
+    size_t len;
+    tb_ini_index index;
+    uint64_t version;   /* starts at 1 and is incremented by every reload */
+    uint64_t mtime;
+} tb_ini_config;
+
+typedef struct tb_ini_reload tb_ini_reload;
+
+/*
+ * called by the reloading thread after config got published and before old is freed
+ * (readers may still see old at this point), tb_ini_index_diff can be used on the indices of
+ * old and config to find out which properties changed
+ */
+typedef void (*tb_ini_reload_func)(void* user, const tb_ini_config* old, const tb_ini_config* config);
+
+/*
+ * Loads the file at path and starts watching it. chunks is passed to tb_ini_index_build.
+ * func may be NULL. Returns NULL on failure (the reason is written to error if not NULL).
+ */
+tb_ini_reload* tb_ini_reload_open(const char* path, size_t chunks, tb_ini_reload_func func, void* user, tb_ini_error* error);
+
+/* stops watching and frees the current config, no reader may hold a config at this point */
+void tb_ini_reload_close(tb_ini_reload* reload);
+
+/*
+ * Returns the current config. It stays valid until it is released with the token written
+ * by acquire, a reader should not hold on to a config for long since it delays freeing it.
+ */
+const tb_ini_config* tb_ini_reload_acquire(tb_ini_reload* reload, unsigned* token);
+void tb_ini_reload_release(tb_ini_reload* reload, unsigned token);
+
+/*
+ * Reloads the file immediately on the calling thread (blocks until the old config is freed).
+ * On failure the current config stays in place.
+ */
+tb_ini_error tb_ini_reload_refresh(tb_ini_reload* reload);
+
+#endif /* !TB_INI_RELOAD_H */
@@ -0,0 +1,60 @@
+#ifndef TB_INI_SNAPSHOT_H
+#define TB_INI_SNAPSHOT_H
+
+#include "tb_ini.h"
+
+/*
+ * Compiled binary snapshot of an ini file.
+ * The snapshot contains sorted section and property tables, pre-parsed numbers and a
+ * string pool. It uses no pointers, so it can be written to a file as is and later be
+ * used directly from a (read-only) memory mapping or any 8 byte aligned buffer.
+ * Lookups are binary searches instead of a scan of the text. As with tb_ini_query the
+ * first occurrence of a section or property wins, a NULL section refers to the
+ * properties before the first section.
+ */
+#define TB_INI_SNAPSHOT_VERSION 1
+
+typedef struct tb_ini_snapshot_header tb_ini_snapshot_header;
+
+typedef struct
+{
+    const tb_ini_snapshot_header* header;
+    const char* data;
+    size_t size;
+} tb_ini_snapshot;
+
+/*
+ * Compiles the ini into a snapshot.
+ * mtime is stored for tb_ini_snapshot_stale and may be 0 if it is not used.
+ * Returns a malloc'd buffer of *size bytes or NULL on failure (the reason is written to error if not NULL).
+ */
+void* tb_ini_snapshot_compile(const char* ini, size_t len, uint64_t mtime, size_t* size, tb_ini_error* error);
+
+/* Checks the header and table bounds of the snapshot data. Does not copy the data. */
+tb_ini_error tb_ini_snapshot_open(tb_ini_snapshot* snapshot, const void* data, size_t size);
+
+/*
+ * Returns 1 if the snapshot is out of date.
+ * If ini is not NULL the content of the source is compared by length and hash (mtime is not
+ * used), else the snapshot is stale if mtime differs from the stored one.
+ */
+int tb_ini_snapshot_stale(const tb_ini_snapshot* snapshot, uint64_t mtime, const char* ini, size_t len);
+
+/*
+ * Works like tb_ini_query, the element points into the string pool (values are zero terminated).
+ * If prop is NULL the section is returned with len being the number of properties.
+ */
+tb_ini_error tb_ini_snapshot_query(const tb_ini_snapshot* snapshot, const char* section, const char* prop, tb_ini_element* element);
+
+/* utility functions to get pre-parsed values */
+int     tb_ini_snapshot_bool(const tb_ini_snapshot* snapshot, const char* section, const char* prop, int def);
+int     tb_ini_snapshot_int(const tb_ini_snapshot* snapshot, const char* section, const char* prop, int def);
+int64_t tb_ini_snapshot_int64(const tb_ini_snapshot* snapshot, const char* section, const char* prop, int64_t def);
+float   tb_ini_snapshot_float(const tb_ini_snapshot* snapshot, const char* section, const char* prop, float def);
+double  tb_ini_snapshot_double(const tb_ini_snapshot* snapshot, const char* section, const char* prop, double def);
+size_t  tb_ini_snapshot_string(const tb_ini_snapshot* snapshot, const char* section, const char* prop, char* dst, size_t dst_len);
+
+/* 64 bit FNV-1a hash used to detect changes of the source */
+uint64_t tb_ini_snapshot_hash(const char* data, size_t len);
+
+#endif /* !TB_INI_SNAPSHOT_H */
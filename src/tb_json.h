@@ -0,0 +1,130 @@
+#ifndef TB_JSON_H
+#define TB_JSON_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * In-place JSON reader.
+ * Like tb_ini this keeps the input as unaltered text and makes queries on it directly, elements
+ * point into the input buffer. The input does not need to be zero terminated and is never
+ * written to, no byte at or after json + len is read.
+ *
+ * Queries only look at the parts of the document they pass through: skipped values are scanned
+ * for strings and brackets but not checked further, returned strings, numbers and literals are
+ * checked completely. Use tb_json_validate to check a whole document.
+ */
+#define TB_JSON_MAX_DEPTH   512
+
+typedef enum
+{
+    TB_JSON_OK,
+    TB_JSON_BAD_PATH,
+    TB_JSON_BAD_SYNTAX,
+    TB_JSON_BAD_TYPE,
+    TB_JSON_NOT_FOUND,
+    TB_JSON_OUT_OF_RANGE,
+    TB_JSON_ALLOC_ERROR
+} tb_json_error;
+
+typedef enum
+{
+    TB_JSON_NULL,
+    TB_JSON_BOOL,
+    TB_JSON_NUMBER,
+    TB_JSON_STRING,
+    TB_JSON_ARRAY,
+    TB_JSON_OBJECT
+} tb_json_type;
+
+typedef struct
+{
+    const char* name;   /* key of object members (without quotes, escapes are not decoded), else NULL */
+    size_t name_len;
+    const char* start;  /* strings without quotes, arrays and objects including their brackets */
+    size_t len;         /* bytelen of value */
+    tb_json_type type;
+    tb_json_error error;
+} tb_json_element;
+
+/*
+ * path query
+ * a path is a list of object keys separated by '.' and array indices in brackets, e.g.
+ * "servers[2].ports[0]". keys are compared with the raw (escaped) key text and can not contain
+ * '.' or '['. an empty or NULL path refers to the root value, if the object has duplicate
+ * keys the first one is used. to query relative to an element pass its start and len.
+ * returns a pointer into the json after the queried value or NULL if it is not found
+ * (element->error is set in both cases)
+ */
+const char* tb_json_query(const char* json, size_t len, const char* path, tb_json_element* element);
+
+/*
+ * steps over the values of an array or the members of an object
+ * stream starts at the element (start of an array or object element) and is the returned
+ * cursor afterwards, returns NULL if the closing bracket is reached (element->error is
+ * TB_JSON_OK) or on error:
+ *
+ *  const char* cursor = array.start;
+ *  while ((cursor = tb_json_step(cursor, array.start + array.len - cursor, &value))) ...
+ */
+const char* tb_json_step(const char* stream, size_t len, tb_json_element* element);
+
+/* returns the number of values of an array or members of an object (0 on error) */
+size_t tb_json_count(const tb_json_element* element);
+
+/*
+ * checked conversion of elements, returns TB_JSON_BAD_TYPE if the element has another type
+ * integers must not have a fraction or exponent, TB_JSON_OUT_OF_RANGE if they do not fit
+ * numbers the fast path can not round are converted with strtod_l in the C locale, on Linux it
+ * needs _GNU_SOURCE, else strtod with the decimal point of the current locale is used
+ */
+tb_json_error tb_json_element_to_bool(const tb_json_element* element, int* value);
+tb_json_error tb_json_element_to_int64(const tb_json_element* element, int64_t* value);
+tb_json_error tb_json_element_to_double(const tb_json_element* element, double* value);
+
+/*
+ * decodes the escapes of a string element into dst (zero terminated, copies at most dst_len bytes
+ * and never splits a multibyte character), the text of other elements is copied as it is
+ * returns the number of bytes written
+ */
+size_t tb_json_element_to_string(const tb_json_element* element, char* dst, size_t dst_len);
+
+/* utility functions to directly convert a query to different types */
+int     tb_json_bool(const char* json, size_t len, const char* path, int def);
+int     tb_json_int(const char* json, size_t len, const char* path, int def);
+int64_t tb_json_int64(const char* json, size_t len, const char* path, int64_t def);
+double  tb_json_double(const char* json, size_t len, const char* path, double def);
+size_t  tb_json_string(const char* json, size_t len, const char* path, char* dst, size_t dst_len);
+
+/* checks the whole document, element points to the position of the first error */
+tb_json_error tb_json_validate(const char* json, size_t len, tb_json_element* element);
+
+/*
+ * structural index
+ * built in one pass over the document, 64 bytes at a time: bitmaps of quotes and backslashes
+ * give the escaped quotes and the string regions (a prefix xor over the quote bits), the
+ * structural characters ({ } [ ] : ,) outside of strings are collected into a list of offsets.
+ * each opening bracket stores the position of its closing bracket, so skipping a value of any
+ * size is a single step and queries never look at the text between the keys they compare.
+ * the index refers to the json buffer, which has to outlive it. documents are limited to 4 GiB.
+ */
+typedef struct
+{
+    const char* json;
+    size_t len;
+    uint32_t* offsets;  /* offsets of the structural characters in document order */
+    uint32_t* jumps;    /* for opening brackets the position of the closing bracket in offsets */
+    size_t count;
+} tb_json_index;
+
+/* returns TB_JSON_BAD_SYNTAX for unterminated strings or unbalanced brackets */
+tb_json_error tb_json_index_build(tb_json_index* index, const char* json, size_t len);
+void tb_json_index_destroy(tb_json_index* index);
+
+/* same as tb_json_query, returns TB_JSON_OK if the value is found */
+tb_json_error tb_json_index_query(const tb_json_index* index, const char* path, tb_json_element* element);
+
+/* returns a string describing the error */
+const char* tb_json_get_error_desc(tb_json_error error);
+
+#endif /* !TB_JSON_H */
@@ -59,3 +59,224 @@ void* tb_mem_dup(tb_allocator* allocator, const void* src, size_t size)
     void* dst = tb_mem_malloc(allocator, size);
     return dst ? memcpy(dst, src, size) : NULL;
 }
+
+/* ----------------------------| Arena |------------------------------------------------------------ */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define TB_ARENA_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define TB_ARENA_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define TB_ARENA_THREAD_LOCAL __declspec(thread)
+#else
+#define TB_ARENA_THREAD_LOCAL
+#endif
+
+struct tb_arena_chunk
+{
+    tb_arena_chunk* prev;
+    size_t size;    /* bytes for allocations behind the header */
+    size_t used;
+};
+
+/* the header is padded, so the first allocation of a chunk is aligned */
+#define TB_ARENA_ALIGN_UP(n)    (((n) + TB_ARENA_ALIGN - 1) & ~(size_t)(TB_ARENA_ALIGN - 1))
+#define TB_ARENA_CHUNK_HDR      TB_ARENA_ALIGN_UP(sizeof(tb_arena_chunk))
+#define TB_ARENA_DATA(chunk)    ((char*)(chunk) + TB_ARENA_CHUNK_HDR)
+
+static tb_arena_chunk* tb_arena_chunk_create(tb_arena* arena, size_t min_size)
+{
+    size_t size = arena->next_size;
+    if (size < min_size) size = min_size;
+
+    tb_allocator* backing = arena->backing;
+    size_t chunk_size = TB_ARENA_CHUNK_HDR + size;
+
+    tb_arena_chunk* chunk = (backing && backing->malloc) ? backing->malloc(chunk_size) : malloc(chunk_size);
+    if (!chunk) return NULL;
+
+    chunk->prev = arena->chunk;
+    chunk->size = size;
+    chunk->used = 0;
+
+    arena->chunk = chunk;
+    if (arena->next_size < TB_ARENA_CHUNK_MAX) arena->next_size *= 2;
+
+    return chunk;
+}
+
+static void tb_arena_chunk_free(tb_arena* arena, tb_arena_chunk* chunk)
+{
+    tb_allocator* backing = arena->backing;
+    if (backing && backing->free)   backing->free(chunk, TB_ARENA_CHUNK_HDR + chunk->size);
+    else                            free(chunk);
+}
+
+/* frees the chunks newer than keep */
+static void tb_arena_pop_chunks(tb_arena* arena, tb_arena_chunk* keep)
+{
+    while (arena->chunk && arena->chunk != keep)
+    {
+        tb_arena_chunk* prev = arena->chunk->prev;
+        tb_arena_chunk_free(arena, arena->chunk);
+        arena->chunk = prev;
+    }
+}
+
+void tb_arena_init(tb_arena* arena, size_t chunk_size, tb_allocator* backing)
+{
+    arena->chunk = NULL;
+    arena->next_size = chunk_size ? TB_ARENA_ALIGN_UP(chunk_size) : TB_ARENA_CHUNK_DEFAULT;
+    arena->last = NULL;
+    arena->backing = backing;
+}
+
+void tb_arena_destroy(tb_arena* arena)
+{
+    tb_arena_pop_chunks(arena, NULL);
+    arena->last = NULL;
+}
+
+void tb_arena_reset(tb_arena* arena)
+{
+    tb_arena_chunk* newest = arena->chunk;
+    if (!newest) return;
+
+    /* the newest chunk is the largest, the older ones are freed */
+    tb_arena_chunk* prev = newest->prev;
+    while (prev)
+    {
+        tb_arena_chunk* next = prev->prev;
+        tb_arena_chunk_free(arena, prev);
+        prev = next;
+    }
+
+    newest->prev = NULL;
+    newest->used = 0;
+    arena->last = NULL;
+}
+
+void* tb_arena_alloc(tb_arena* arena, size_t size)
+{
+    if (size == 0) return NULL;
+
+    size_t aligned = TB_ARENA_ALIGN_UP(size);
+    if (aligned < size) return NULL; /* overflow */
+
+    tb_arena_chunk* chunk = arena->chunk;
+    if (!chunk || chunk->size - chunk->used < aligned)
+    {
+        chunk = tb_arena_chunk_create(arena, aligned);
+        if (!chunk) return NULL;
+    }
+
+    void* block = TB_ARENA_DATA(chunk) + chunk->used;
+    chunk->used += aligned;
+
+    arena->last = block;
+    return block;
+}
+
+void* tb_arena_calloc(tb_arena* arena, size_t count, size_t size)
+{
+    if (size && count > (size_t)-1 / size) return NULL; /* overflow */
+
+    void* block = tb_arena_alloc(arena, count * size);
+    return block ? memset(block, 0, count * size) : NULL;
+}
+
+void* tb_arena_realloc(tb_arena* arena, void* block, size_t old_size, size_t new_size)
+{
+    if (!block) return tb_arena_alloc(arena, new_size);
+
+    if (new_size == 0)
+    {
+        tb_arena_free(arena, block);
+        return NULL;
+    }
+
+    /* the last allocation only moves the top of its chunk */
+    tb_arena_chunk* chunk = arena->chunk;
+    if (block == arena->last && chunk)
+    {
+        size_t offset = (size_t)((char*)block - TB_ARENA_DATA(chunk));
+        size_t aligned = TB_ARENA_ALIGN_UP(new_size);
+
+        if (aligned >= new_size && aligned <= chunk->size - offset)
+        {
+            chunk->used = offset + aligned;
+            return block;
+        }
+    }
+
+    void* new_block = tb_arena_alloc(arena, new_size);
+    if (!new_block) return NULL;
+
+    memcpy(new_block, block, (old_size < new_size) ? old_size : new_size);
+    return new_block;
+}
+
+void tb_arena_free(tb_arena* arena, void* block)
+{
+    if (!block || block != arena->last || !arena->chunk) return;
+
+    arena->chunk->used = (size_t)((char*)block - TB_ARENA_DATA(arena->chunk));
+    arena->last = NULL;
+}
+
+tb_arena_marker tb_arena_save(const tb_arena* arena)
+{
+    tb_arena_marker marker;
+    marker.chunk = arena->chunk;
+    marker.used = arena->chunk ? arena->chunk->used : 0;
+    return marker;
+}
+
+void tb_arena_restore(tb_arena* arena, tb_arena_marker marker)
+{
+    tb_arena_pop_chunks(arena, marker.chunk);
+
+    if (arena->chunk) arena->chunk->used = marker.used;
+    arena->last = NULL;
+}
+
+/* ----------------------------| Arena hooks |------------------------------------------------------ */
+static TB_ARENA_THREAD_LOCAL tb_arena* tb_arena_bound = NULL;
+
+tb_arena* tb_arena_bind(tb_arena* arena)
+{
+    tb_arena* prev = tb_arena_bound;
+    tb_arena_bound = arena;
+    return prev;
+}
+
+static void* tb_arena_allocator_malloc(size_t size)
+{
+    return tb_arena_bound ? tb_arena_alloc(tb_arena_bound, size) : NULL;
+}
+
+static void* tb_arena_allocator_realloc(void* block, size_t old_size, size_t new_size)
+{
+    return tb_arena_bound ? tb_arena_realloc(tb_arena_bound, block, old_size, new_size) : NULL;
+}
+
+static void tb_arena_allocator_free(void* block, size_t size)
+{
+    (void)size;
+    if (tb_arena_bound) tb_arena_free(tb_arena_bound, block);
+}
+
+tb_allocator* tb_arena_allocator(void)
+{
+    static tb_allocator allocator = { tb_arena_allocator_malloc, tb_arena_allocator_realloc, tb_arena_allocator_free };
+    return &allocator;
+}
+
+void* tb_arena_hashmap_alloc(void* arena, size_t count, size_t size)
+{
+    return tb_arena_calloc(arena, count, size);
+}
+
+void tb_arena_hashmap_free(void* arena, void* block)
+{
+    tb_arena_free(arena, block);
+}
@@ -22,4 +22,73 @@ void  tb_mem_constfree(tb_allocator* allocator, const void* block);
 
 void* tb_mem_dup(tb_allocator* allocator, const void* src, size_t size);
 
+/*
+ * Arena (bump) allocator. Memory is taken from chunks that double in size (up to
+ * TB_ARENA_CHUNK_MAX), an allocation only moves the top of the current chunk. Single blocks
+ * are not freed, except for the last allocation, which can also be resized in place.
+ * Everything is released at once with tb_arena_reset (keeps the newest chunk for reuse) or
+ * tb_arena_destroy, or back to a marker saved with tb_arena_save for temporary allocations.
+ * Allocations are aligned to TB_ARENA_ALIGN, oversized ones get a chunk of their own.
+ */
+#define TB_ARENA_ALIGN          16
+#define TB_ARENA_CHUNK_DEFAULT  (1 << 16)
+#define TB_ARENA_CHUNK_MAX      (1 << 24)
+
+typedef struct tb_arena_chunk tb_arena_chunk;
+
+typedef struct
+{
+    tb_arena_chunk* chunk;  /* current chunk, linked to the previous ones */
+    size_t next_size;       /* size of the next chunk */
+    void* last;             /* last allocation, NULL if it was freed */
+    tb_allocator* backing;  /* allocator of the chunks, NULL for malloc/free */
+} tb_arena;
+
+typedef struct
+{
+    tb_arena_chunk* chunk;
+    size_t used;
+} tb_arena_marker;
+
+/* chunk_size is the size of the first chunk (0 for TB_ARENA_CHUNK_DEFAULT), backing may be NULL */
+void tb_arena_init(tb_arena* arena, size_t chunk_size, tb_allocator* backing);
+void tb_arena_destroy(tb_arena* arena);
+
+/* Frees everything allocated from the arena, the newest chunk is kept. */
+void tb_arena_reset(tb_arena* arena);
+
+/* Returns NULL if size is 0 or memory allocation failed. */
+void* tb_arena_alloc(tb_arena* arena, size_t size);
+void* tb_arena_calloc(tb_arena* arena, size_t count, size_t size);
+
+/*
+ * The last allocation is resized in place as long as it fits into its chunk, other blocks are
+ * copied into a new allocation. A block of size 0 is freed and NULL is returned.
+ */
+void* tb_arena_realloc(tb_arena* arena, void* block, size_t old_size, size_t new_size);
+
+/* Only the last allocation is given back, freeing other blocks does nothing. */
+void tb_arena_free(tb_arena* arena, void* block);
+
+/*
+ * Markers for temporary allocations: restore frees everything allocated after save.
+ * Markers have to be restored in reverse order and are invalidated by tb_arena_reset.
+ */
+tb_arena_marker tb_arena_save(const tb_arena* arena);
+void tb_arena_restore(tb_arena* arena, tb_arena_marker marker);
+
+/*
+ * tb_allocator callbacks get no context, so tb_arena_allocator allocates from the arena bound
+ * to the calling thread with tb_arena_bind (which returns the previously bound one for nesting).
+ * Blocks must be resized and freed while the same arena is bound, all of them become invalid
+ * once the arena is reset or destroyed. Without an arena bound the allocator fails.
+ * Without thread local storage (C11, GCC or MSVC) a single arena is bound for all threads.
+ */
+tb_arena* tb_arena_bind(tb_arena* arena);
+tb_allocator* tb_arena_allocator(void);
+
+/* Hooks with the signature of the tb_hashmap alloc and free callbacks, the allocator is the arena. */
+void* tb_arena_hashmap_alloc(void* arena, size_t count, size_t size);
+void  tb_arena_hashmap_free(void* arena, void* block);
+
 #endif /* !TB_MEM_H */
@@ -0,0 +1,55 @@
+#ifndef TB_QUEUE_H
+#define TB_QUEUE_H
+
+#include <stddef.h>
+
+/*
+ * Lock-free bounded queues for fixed size elements, which are copied in and out.
+ * The capacity is rounded up to a power of two. Enqueue and dequeue never block, they return
+ * the number of elements that fit or were available (possibly 0), batches move up to n elements
+ * with a single synchronization.
+ *
+ * tb_spsc: one producer and one consumer thread. Each side keeps a cached copy of the other
+ *          side's index and only reads the shared index when the cached one says the queue is
+ *          full (or empty), so the indices do not bounce between the caches of the two threads.
+ *
+ * tb_mpmc: any number of producer and consumer threads (Dmitry Vyukov's bounded queue). Every
+ *          cell has a sequence number that tells whether it is free for the enqueue or ready
+ *          for the dequeue at a position, positions are claimed with a compare and swap.
+ *
+ * Requires C11 atomics.
+ */
+
+typedef struct tb_spsc tb_spsc;
+typedef struct tb_mpmc tb_mpmc;
+
+/* Returns NULL if memory allocation failed or elem_size or capacity is 0. */
+tb_spsc* tb_spsc_create(size_t capacity, size_t elem_size);
+void     tb_spsc_destroy(tb_spsc* queue);
+
+/* Producer only: copies up to n elements from src into the queue, returns the number enqueued. */
+size_t tb_spsc_enqueue(tb_spsc* queue, const void* src, size_t n);
+
+/* Consumer only: copies up to n elements out of the queue to dst, returns the number dequeued. */
+size_t tb_spsc_dequeue(tb_spsc* queue, void* dst, size_t n);
+
+/* Number of elements in the queue, only a snapshot if the other side is running. */
+size_t tb_spsc_len(tb_spsc* queue);
+size_t tb_spsc_cap(const tb_spsc* queue);
+
+/* Returns NULL if memory allocation failed or elem_size or capacity is 0. */
+tb_mpmc* tb_mpmc_create(size_t capacity, size_t elem_size);
+void     tb_mpmc_destroy(tb_mpmc* queue);
+
+/*
+ * Copies up to n elements from src into the queue, returns the number enqueued.
+ * A batch claims consecutive positions, it stops early at the first cell that is still in use.
+ */
+size_t tb_mpmc_enqueue(tb_mpmc* queue, const void* src, size_t n);
+
+/* Copies up to n elements out of the queue to dst, returns the number dequeued. */
+size_t tb_mpmc_dequeue(tb_mpmc* queue, void* dst, size_t n);
+
+size_t tb_mpmc_cap(const tb_mpmc* queue);
+
+#endif /* !TB_QUEUE_H */
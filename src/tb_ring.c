@@ -0,0 +1,143 @@
+#include "tb_ring.h"
+
+#include <string.h>
+
+#define tb_ring__hdr(r) ((size_t*)(void*)(r) - 4)
+
+static void* tb_ring_resize(void* ring, size_t new_cap, size_t elem_size)
+{
+    size_t* hdr = ring ? tb_ring__hdr(ring) : NULL;
+    size_t old_cap = tb_ring_cap(ring);
+
+    hdr = realloc(hdr, TB_RING_HDR_SIZE + (new_cap * elem_size));
+
+    if (!hdr) return NULL; /* out of memory */
+
+    char* data = (char*)(hdr + 4);
+    if (!ring)
+    {
+        hdr[0] = 0;
+        hdr[1] = 0;
+        hdr[3] = 0;
+    }
+
+    /*
+     * a wrapped ring continues behind the old capacity, either the part at the start of the buffer
+     * is moved behind the old end or the part at the end is moved to the new end, whichever is smaller
+     */
+    size_t head = hdr[0];
+    size_t len = hdr[3];
+    if (head + len > old_cap)
+    {
+        size_t tail = head + len - old_cap;
+        size_t front = old_cap - head;
+
+        if (tail <= front)
+        {
+            memcpy(data + (old_cap * elem_size), data, tail * elem_size);
+        }
+        else
+        {
+            memcpy(data + ((new_cap - front) * elem_size), data + (head * elem_size), front * elem_size);
+            hdr[0] = new_cap - front;
+        }
+    }
+
+    hdr[2] = new_cap;
+    return data;
+}
+
+static size_t tb_ring_pow2(size_t n)
+{
+    size_t cap = 1;
+    while (cap < n) cap <<= 1;
+    return cap;
+}
+
+void* tb_ring__grow(void* ring, size_t increment, size_t elem_size)
+{
+    if (ring && tb_array__len(ring) + increment <= tb_array__cap(ring)) return ring;
+
+    size_t new_size = tb_ring_len(ring) + increment;
+    size_t new_cap = ring ? 2 * tb_array__cap(ring) : 1;
+
+    return tb_ring_resize(ring, tb_ring_pow2((new_cap < new_size) ? new_size : new_cap), elem_size);
+}
+
+void* tb_ring__reserve(void* ring, size_t reserve, size_t elem_size)
+{
+    if (ring && reserve <= tb_array__cap(ring)) return ring;
+    return tb_ring_resize(ring, tb_ring_pow2(reserve), elem_size);
+}
+
+void tb_ring__free(void* ring)
+{
+    if (ring) free(tb_ring__hdr(ring));
+}
+
+size_t tb_ring__first_len(const void* ring)
+{
+    size_t to_end = tb_array__cap(ring) - tb_ring__head(ring);
+    return (tb_array__len(ring) < to_end) ? tb_array__len(ring) : to_end;
+}
+
+size_t tb_ring__push_front(void* ring)
+{
+    tb_ring__head(ring) = (tb_ring__head(ring) - 1) & tb_ring__mask(ring);
+    tb_array__len(ring)++;
+    return tb_ring__head(ring);
+}
+
+size_t tb_ring__pop_front(void* ring)
+{
+    size_t head = tb_ring__head(ring);
+    tb_ring__head(ring) = (head + 1) & tb_ring__mask(ring);
+    tb_array__len(ring)--;
+    return head;
+}
+
+size_t tb_ring__pop_back(void* ring)
+{
+    return tb_ring__index(ring, --tb_array__len(ring));
+}
+
+void* tb_ring__write(void* ring, const void* src, size_t n, size_t elem_size)
+{
+    if (n == 0) return ring;
+
+    ring = tb_ring__grow(ring, n, elem_size);
+    if (!ring) return NULL; /* out of memory */
+
+    size_t cap = tb_array__cap(ring);
+    size_t tail = tb_ring__index(ring, tb_array__len(ring));
+    size_t first = (n < cap - tail) ? n : cap - tail;
+
+    char* data = ring;
+    memcpy(data + (tail * elem_size), src, first * elem_size);
+    memcpy(data, (const char*)src + (first * elem_size), (n - first) * elem_size);
+
+    tb_array__len(ring) += n;
+    return ring;
+}
+
+size_t tb_ring__read(void* ring, void* dst, size_t n, size_t elem_size)
+{
+    size_t len = tb_ring_len(ring);
+    if (n > len) n = len;
+    if (n == 0) return 0;
+
+    size_t head = tb_ring__head(ring);
+    size_t first = tb_ring__first_len(ring);
+    if (first > n) first = n;
+
+    if (dst)
+    {
+        const char* data = ring;
+        memcpy(dst, data + (head * elem_size), first * elem_size);
+        memcpy((char*)dst + (first * elem_size), data, (n - first) * elem_size);
+    }
+
+    tb_ring__head(ring) = (head + n) & tb_ring__mask(ring);
+    tb_array__len(ring) -= n;
+    return n;
+}
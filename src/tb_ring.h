@@ -0,0 +1,75 @@
+#ifndef TB_RING_H
+#define TB_RING_H
+
+#include "tb_array.h"
+
+/*
+ * Growable ring buffer (deque) in the style of tb_array. A ring is a pointer to its elements
+ * (NULL is an empty ring) with the head index in front of the regular tb_array header, so
+ * tb_array_len and tb_array_cap also work on rings. The capacity is always a power of two
+ * and element i of the ring is found at (head + i) & (cap - 1).
+ *
+ * Push and pop are O(1) at both ends, growth doubles the capacity and moves only the smaller
+ * of the two wrapped parts. The elements are at most two contiguous spans: the first span
+ * starts at the head, the second one (if the ring wraps) at the start of the buffer.
+ *
+ * A ring must be freed with tb_ring_free, not tb_array_free.
+ */
+#define TB_RING_HDR_SIZE    4 * sizeof(TB_ARRAY_HDR_ELEM)
+
+#define tb_ring__head(r)    ((size_t*)(void*)(r) - 4)[0]
+#define tb_ring__mask(r)    (tb_array__cap(r) - 1)
+#define tb_ring__index(r, i) ((tb_ring__head(r) + (i)) & tb_ring__mask(r))
+
+#define tb_ring_len(r)      tb_array_len(r)
+#define tb_ring_cap(r)      tb_array_cap(r)
+#define tb_ring_empty(r)    (tb_ring_len(r) == 0)
+
+#define tb_ring_grow(r, n)      (*((void**)&(r)) = tb_ring__grow((r), (n), sizeof(*(r))))
+#define tb_ring_reserve(r, n)   (*((void**)&(r)) = tb_ring__reserve((r), (n), sizeof(*(r))))
+#define tb_ring_free(r)         (tb_ring__free(r), (r) = NULL)
+#define tb_ring_clear(r)        ((r) ? tb_array__len(r) = 0, tb_ring__head(r) = 0 : 0)
+
+/* element i counted from the front (i < len) */
+#define tb_ring_at(r, i)    (r)[tb_ring__index((r), (i))]
+#define tb_ring_front(r)    (r)[tb_ring__head(r)]
+#define tb_ring_back(r)     (r)[tb_ring__index((r), tb_array__len(r) - 1)]
+
+#define tb_ring_push_back(r, v)     (tb_ring_grow((r), 1), (r)[tb_ring__index((r), tb_array__len(r)++)] = (v))
+#define tb_ring_push_front(r, v)    (tb_ring_grow((r), 1), (r)[tb_ring__push_front(r)] = (v))
+
+/* remove and return the element at the front or back, the ring must not be empty */
+#define tb_ring_pop_front(r)    (r)[tb_ring__pop_front(r)]
+#define tb_ring_pop_back(r)     (r)[tb_ring__pop_back(r)]
+
+/*
+ * the two contiguous spans of the ring, in order
+ * the second span is empty unless the ring wraps around the end of the buffer
+ */
+#define tb_ring_first_span(r)   ((r) ? (r) + tb_ring__head(r) : NULL)
+#define tb_ring_first_len(r)    ((r) ? tb_ring__first_len(r) : 0)
+#define tb_ring_second_span(r)  (r)
+#define tb_ring_second_len(r)   (tb_ring_len(r) - tb_ring_first_len(r))
+
+/*
+ * bulk operations, each does at most one reallocation and two memcpys
+ * tb_ring_push_back_n: appends n elements copied from src
+ * tb_ring_pop_front_n: removes up to n elements from the front and copies them to dst (dst may be NULL),
+ *                      returns the number of removed elements
+ */
+#define tb_ring_push_back_n(r, src, n)  (*((void**)&(r)) = tb_ring__write((r), (src), (n), sizeof(*(r))))
+#define tb_ring_pop_front_n(r, dst, n)  (tb_ring__read((r), (dst), (n), sizeof(*(r))))
+
+void* tb_ring__grow(void* ring, size_t increment, size_t elem_size);
+void* tb_ring__reserve(void* ring, size_t reserve, size_t elem_size);
+void  tb_ring__free(void* ring);
+
+size_t tb_ring__first_len(const void* ring);
+size_t tb_ring__push_front(void* ring);
+size_t tb_ring__pop_front(void* ring);
+size_t tb_ring__pop_back(void* ring);
+
+void*  tb_ring__write(void* ring, const void* src, size_t n, size_t elem_size);
+size_t tb_ring__read(void* ring, void* dst, size_t n, size_t elem_size);
+
+#endif /* !TB_RING_H */
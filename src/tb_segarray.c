@@ -0,0 +1,159 @@
+#include "tb_segarray.h"
+
+#include <string.h>
+
+#define TB_SEGARRAY_TABLE_MIN   8
+
+static void* tb_segarray_alloc(tb_segarray* arr, size_t size)
+{
+    tb_allocator* allocator = arr->allocator;
+    return (allocator && allocator->malloc) ? allocator->malloc(size) : malloc(size);
+}
+
+static void tb_segarray_free(tb_segarray* arr, void* block, size_t size)
+{
+    tb_allocator* allocator = arr->allocator;
+    if (allocator && allocator->free)   allocator->free(block, size);
+    else                                free(block);
+}
+
+static size_t tb_segarray_chunk_size(const tb_segarray* arr)
+{
+    return (arr->mask + 1) * arr->elem_size;
+}
+
+/* the table only holds pointers, growing it copies chunk_count pointers but no elements */
+static int tb_segarray_grow_table(tb_segarray* arr, size_t min_cap)
+{
+    if (min_cap <= arr->table_cap) return 1;
+
+    size_t new_cap = arr->table_cap ? arr->table_cap : TB_SEGARRAY_TABLE_MIN;
+    while (new_cap < min_cap) new_cap <<= 1;
+
+    size_t old_size = arr->table_cap * sizeof(char*);
+    size_t new_size = new_cap * sizeof(char*);
+
+    tb_allocator* allocator = arr->allocator;
+    char** table = (allocator && allocator->realloc) ? allocator->realloc(arr->chunks, old_size, new_size) : realloc(arr->chunks, new_size);
+
+    if (!table) return 0;
+
+    arr->chunks = table;
+    arr->table_cap = new_cap;
+    return 1;
+}
+
+tb_segarray_error tb_segarray_init(tb_segarray* arr, size_t elem_size, size_t chunk_elems, tb_allocator* allocator)
+{
+    if (!arr || !elem_size) return TB_SEGARRAY_ERROR;
+
+    if (!chunk_elems) chunk_elems = TB_SEGARRAY_CHUNK_DEFAULT / elem_size;
+
+    size_t shift = 0;
+    while (((size_t)1 << shift) < chunk_elems) shift++;
+
+    arr->chunks = NULL;
+    arr->chunk_count = 0;
+    arr->table_cap = 0;
+    arr->len = 0;
+    arr->elem_size = elem_size;
+    arr->shift = shift;
+    arr->mask = ((size_t)1 << shift) - 1;
+    arr->allocator = allocator;
+
+    return TB_SEGARRAY_OK;
+}
+
+void tb_segarray_destroy(tb_segarray* arr)
+{
+    if (!arr) return;
+
+    tb_segarray_clear(arr);
+    tb_segarray_shrink(arr);
+}
+
+void* tb_segarray_get(const tb_segarray* arr, size_t index)
+{
+    if (!arr || index >= arr->len) return NULL;
+    return tb_segarray_at(arr, index);
+}
+
+void* tb_segarray_push(tb_segarray* arr, const void* src)
+{
+    size_t chunk = arr->len >> arr->shift;
+    if (chunk >= arr->chunk_count && tb_segarray_reserve(arr, arr->len + 1) != TB_SEGARRAY_OK) return NULL;
+
+    char* elem = arr->chunks[chunk] + ((arr->len++ & arr->mask) * arr->elem_size);
+    if (src) memcpy(elem, src, arr->elem_size);
+
+    return elem;
+}
+
+tb_segarray_error tb_segarray_pop(tb_segarray* arr)
+{
+    if (!arr->len) return TB_SEGARRAY_OUT_OF_RANGE;
+
+    arr->len--;
+    return TB_SEGARRAY_OK;
+}
+
+tb_segarray_error tb_segarray_reserve(tb_segarray* arr, size_t cap)
+{
+    size_t count = (cap + arr->mask) >> arr->shift;
+    if (count <= arr->chunk_count) return TB_SEGARRAY_OK;
+
+    if (!tb_segarray_grow_table(arr, count)) return TB_SEGARRAY_ALLOC_ERROR;
+
+    size_t chunk_size = tb_segarray_chunk_size(arr);
+    while (arr->chunk_count < count)
+    {
+        char* chunk = tb_segarray_alloc(arr, chunk_size);
+        if (!chunk) return TB_SEGARRAY_ALLOC_ERROR;
+
+        arr->chunks[arr->chunk_count++] = chunk;
+    }
+
+    return TB_SEGARRAY_OK;
+}
+
+tb_segarray_error tb_segarray_resize(tb_segarray* arr, size_t len)
+{
+    tb_segarray_error error = tb_segarray_reserve(arr, len);
+    if (error != TB_SEGARRAY_OK) return error;
+
+    arr->len = len;
+    return TB_SEGARRAY_OK;
+}
+
+void tb_segarray_clear(tb_segarray* arr)
+{
+    arr->len = 0;
+}
+
+void tb_segarray_shrink(tb_segarray* arr)
+{
+    size_t used = (arr->len + arr->mask) >> arr->shift;
+    size_t chunk_size = tb_segarray_chunk_size(arr);
+
+    while (arr->chunk_count > used)
+        tb_segarray_free(arr, arr->chunks[--arr->chunk_count], chunk_size);
+
+    if (used == 0 && arr->chunks)
+    {
+        tb_segarray_free(arr, arr->chunks, arr->table_cap * sizeof(char*));
+        arr->chunks = NULL;
+        arr->table_cap = 0;
+    }
+}
+
+const char* tb_segarray_get_error_desc(tb_segarray_error error)
+{
+    switch (error)
+    {
+    case TB_SEGARRAY_OK:            return "no error";
+    case TB_SEGARRAY_ERROR:         return "error";
+    case TB_SEGARRAY_ALLOC_ERROR:   return "allocation failed";
+    case TB_SEGARRAY_OUT_OF_RANGE:  return "index out of range";
+    default:                        return "unkown error";
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef TB_SEGARRAY_H
+#define TB_SEGARRAY_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "tb_mem.h"
+
+/*
+ * Segmented array: the elements are stored in fixed size chunks of a power of two elements
+ * that are found through a chunk table. Growing the array only adds chunks, the elements are
+ * never moved, so pointers to them stay valid until they are removed. Random access is one
+ * shift, one mask and two loads.
+ *
+ * Chunks that are no longer used after pop, resize or clear stay in the chunk table and are
+ * recycled once the array grows again, tb_segarray_shrink gives them back to the allocator.
+ */
+
+#define TB_SEGARRAY_CHUNK_DEFAULT   4096 /* bytes per chunk if no element count is given */
+
+typedef enum
+{
+    TB_SEGARRAY_OK = 0,
+    TB_SEGARRAY_ERROR,
+    TB_SEGARRAY_ALLOC_ERROR,
+    TB_SEGARRAY_OUT_OF_RANGE
+} tb_segarray_error;
+
+typedef struct
+{
+    char** chunks;          /* chunk table */
+    size_t chunk_count;     /* allocated chunks, the first chunk_count entries of the table */
+    size_t table_cap;
+
+    size_t len;
+    size_t elem_size;
+
+    size_t shift;           /* log2 of the elements per chunk */
+    size_t mask;            /* elements per chunk - 1 */
+
+    tb_allocator* allocator;
+} tb_segarray;
+
+/*
+ * Initialize an empty segmented array for elements of elem_size bytes.
+ * chunk_elems is rounded up to a power of two, 0 picks a chunk of about TB_SEGARRAY_CHUNK_DEFAULT bytes.
+ * allocator may be NULL for malloc/realloc/free.
+ */
+tb_segarray_error tb_segarray_init(tb_segarray* arr, size_t elem_size, size_t chunk_elems, tb_allocator* allocator);
+
+/* Free all chunks and the chunk table. */
+void tb_segarray_destroy(tb_segarray* arr);
+
+/* Unchecked access to the element at index i (i < len). */
+#define tb_segarray_at(arr, i) ((void*)((arr)->chunks[(i) >> (arr)->shift] + (((i) & (arr)->mask) * (arr)->elem_size)))
+
+#define tb_segarray_len(arr)        ((arr)->len)
+#define tb_segarray_cap(arr)        ((arr)->chunk_count << (arr)->shift)
+#define tb_segarray_chunk_len(arr)  ((arr)->mask + 1)
+
+/* Return the element at index, or NULL if index is out of range. */
+void* tb_segarray_get(const tb_segarray* arr, size_t index);
+
+/*
+ * Append a copy of the element at src (uninitialized if src is NULL).
+ * Returns a pointer to the new element, which stays valid until it is removed, or NULL if memory allocation failed.
+ */
+void* tb_segarray_push(tb_segarray* arr, const void* src);
+
+/* Remove the last element, returns TB_SEGARRAY_OUT_OF_RANGE if the array is empty. */
+tb_segarray_error tb_segarray_pop(tb_segarray* arr);
+
+/* Make room for at least cap elements without changing the length. */
+tb_segarray_error tb_segarray_reserve(tb_segarray* arr, size_t cap);
+
+/* Change the length to len, new elements are uninitialized. */
+tb_segarray_error tb_segarray_resize(tb_segarray* arr, size_t len);
+
+/* Remove all elements, the chunks are kept for reuse. */
+void tb_segarray_clear(tb_segarray* arr);
+
+/* Free the chunks that are not used by any element. */
+void tb_segarray_shrink(tb_segarray* arr);
+
+const char* tb_segarray_get_error_desc(tb_segarray_error error);
+
+#endif /* !TB_SEGARRAY_H */
@@ -0,0 +1,71 @@
+#include "tb_soa.h"
+
+#include <stdint.h>
+
+static size_t tb_soa_align(size_t size)
+{
+    return (size + TB_SOA_ALIGN - 1) & ~(size_t)(TB_SOA_ALIGN - 1);
+}
+
+static char* tb_soa_align_ptr(char* block)
+{
+    uintptr_t base = (uintptr_t)block;
+    return block + ((TB_SOA_ALIGN - (base & (TB_SOA_ALIGN - 1))) & (TB_SOA_ALIGN - 1));
+}
+
+int tb_soa__resize(void** block, void** columns, const size_t* sizes, size_t count, size_t len, size_t old_cap, size_t cap)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) total += tb_soa_align(cap * sizes[i]);
+
+    char* old_block = *block;
+    size_t old_pad = old_block ? (size_t)((char*)columns[0] - old_block) : 0;
+
+    /* malloc only guarantees the alignment of the largest scalar type */
+    char* new_block = realloc(old_block, total + TB_SOA_ALIGN - 1);
+    if (!new_block) return 0; /* out of memory */
+
+    /*
+     * realloc kept the old layout, the columns are moved to their new offsets in place.
+     * the distance each column moves only grows from the first to the last column, so the
+     * columns that move down are moved front to back and the others back to front.
+     */
+    char* src = new_block + old_pad;
+    char* dst = tb_soa_align_ptr(new_block);
+
+    size_t i = 0;
+    for (; i < count && dst <= src; ++i)
+    {
+        if (len && dst < src) memmove(dst, src, len * sizes[i]);
+
+        columns[i] = dst;
+        src += tb_soa_align(old_cap * sizes[i]);
+        dst += tb_soa_align(cap * sizes[i]);
+    }
+
+    size_t first_up = i;
+    for (; i < count; ++i)
+    {
+        columns[i] = dst;
+        dst += tb_soa_align(cap * sizes[i]);
+    }
+
+    /* the old offsets of the remaining columns, walked backwards */
+    src = new_block + old_pad;
+    for (i = 0; i < count; ++i) src += tb_soa_align(old_cap * sizes[i]);
+
+    for (i = count; i-- > first_up;)
+    {
+        src -= tb_soa_align(old_cap * sizes[i]);
+        if (len) memmove(columns[i], src, len * sizes[i]);
+    }
+
+    *block = new_block;
+    return 1;
+}
+
+size_t tb_soa__grow_cap(size_t cap, size_t min_cap)
+{
+    size_t new_cap = cap ? 2 * cap : 16;
+    return (new_cap < min_cap) ? min_cap : new_cap;
+}
@@ -0,0 +1,114 @@
+#ifndef TB_SOA_H
+#define TB_SOA_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Struct of arrays containers generated from a field list. Every field becomes its own array
+ * (column), all columns share one length and capacity and live in a single block, each of
+ * them aligned to TB_SOA_ALIGN bytes. Loops that only touch some fields only stream those
+ * columns and the compiler can vectorize them like plain arrays.
+ *
+ * The field list is an X macro:
+ *
+ *     #define PARTICLE_FIELDS(X)  X(float, x) X(float, y) X(int, id)
+ *     TB_SOA_DECLARE(particles, PARTICLE_FIELDS)
+ *
+ * declares the type particles with the members float* x, float* y, int* id, len and cap and
+ * the functions (fields may not be named len, cap, block or soa):
+ *
+ *     int  particles_reserve(particles* soa, size_t cap)      room for cap elements
+ *     int  particles_grow(particles* soa, size_t n)           room for n more elements
+ *     int  particles_resize(particles* soa, size_t len)       new elements are uninitialized
+ *     int  particles_push(particles* soa, float x, float y, int id)
+ *     void particles_swap_remove(particles* soa, size_t index)
+ *     void particles_clear(particles* soa)
+ *     void particles_free(particles* soa)
+ *
+ * the int functions return 0 if memory allocation failed, the container is unchanged then.
+ * a zero initialized container is empty. growth doubles the capacity and reallocates the block,
+ * so pointers into the columns are invalidated like with tb_array.
+ */
+
+#define TB_SOA_ALIGN    64
+
+#define TB_SOA__MEMBER(type, field) type* field;
+#define TB_SOA__PARAM(type, field)  , type field
+#define TB_SOA__PTR(type, field)    (void*)soa->field,
+#define TB_SOA__SIZE(type, field)   sizeof(type),
+#define TB_SOA__SET(type, field)    soa->field = *column++;
+#define TB_SOA__STORE(type, field)  soa->field[soa->len] = field;
+#define TB_SOA__MOVE(type, field)   soa->field[index] = soa->field[soa->len];
+
+#define TB_SOA_DECLARE(name, fields)                                                                \
+    typedef struct name                                                                             \
+    {                                                                                               \
+        fields(TB_SOA__MEMBER)                                                                      \
+        size_t len;                                                                                 \
+        size_t cap;                                                                                 \
+        void* block;                                                                                \
+    } name;                                                                                         \
+                                                                                                    \
+    static inline int name##_reserve(name* soa, size_t cap)                                         \
+    {                                                                                               \
+        if (cap <= soa->cap) return 1;                                                              \
+                                                                                                    \
+        void* columns[] = { fields(TB_SOA__PTR) };                                                  \
+        const size_t sizes[] = { fields(TB_SOA__SIZE) };                                            \
+        size_t count = sizeof(sizes) / sizeof(sizes[0]);                                            \
+                                                                                                    \
+        if (!tb_soa__resize(&soa->block, columns, sizes, count, soa->len, soa->cap, cap)) return 0; \
+                                                                                                    \
+        void** column = columns;                                                                    \
+        fields(TB_SOA__SET)                                                                         \
+        soa->cap = cap;                                                                             \
+        return 1;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_grow(name* soa, size_t n)                                              \
+    {                                                                                               \
+        if (soa->len + n <= soa->cap) return 1;                                                     \
+        return name##_reserve(soa, tb_soa__grow_cap(soa->cap, soa->len + n));                       \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_resize(name* soa, size_t len)                                          \
+    {                                                                                               \
+        if (len > soa->len && !name##_grow(soa, len - soa->len)) return 0;                          \
+        soa->len = len;                                                                             \
+        return 1;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline int name##_push(name* soa fields(TB_SOA__PARAM))                                  \
+    {                                                                                               \
+        if (!name##_grow(soa, 1)) return 0;                                                         \
+        fields(TB_SOA__STORE)                                                                       \
+        soa->len++;                                                                                 \
+        return 1;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline void name##_swap_remove(name* soa, size_t index)                                  \
+    {                                                                                               \
+        soa->len--;                                                                                 \
+        fields(TB_SOA__MOVE)                                                                        \
+    }                                                                                               \
+                                                                                                    \
+    static inline void name##_clear(name* soa) { soa->len = 0; }                                    \
+                                                                                                    \
+    static inline void name##_free(name* soa)                                                       \
+    {                                                                                               \
+        free(soa->block);                                                                           \
+        memset(soa, 0, sizeof(*soa));                                                               \
+    }
+
+/*
+ * reallocates the block of count columns with the given element sizes from old_cap to cap elements
+ * and moves the first len elements of each column to its new offset, aligned to TB_SOA_ALIGN
+ * returns 0 if memory allocation failed, the columns and the block are unchanged then
+ */
+int tb_soa__resize(void** block, void** columns, const size_t* sizes, size_t count, size_t len, size_t old_cap, size_t cap);
+
+size_t tb_soa__grow_cap(size_t cap, size_t min_cap);
+
+#endif /* !TB_SOA_H */
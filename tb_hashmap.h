@@ -285,7 +285,7 @@ static void tb_hashmap_remove_entry(tb_hashmap* map, tb_hashmap_entry* removed_e
 
 static tb_hashmap_error tb_hashmap_rehash(tb_hashmap* map, size_t new_capacity)
 {
-    if ((new_capacity >= TB_HASHMAP_SIZE_MIN) || ((new_capacity & (new_capacity - 1)) == 0))
+    if ((new_capacity < TB_HASHMAP_SIZE_MIN) || ((new_capacity & (new_capacity - 1)) != 0))
         return TB_HASHMAP_ERROR;
 
     tb_hashmap_entry* new_table = tb_hashmap_alloc_table(map, new_capacity);
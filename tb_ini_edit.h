@@ -0,0 +1,596 @@
+#ifndef TB_INI_EDIT_H
+#define TB_INI_EDIT_H
+
+#include "tb_ini.h"
+
+/*
+ * Editing of ini buffers without rewriting them.
+ * The original text is never modified (or copied), edits are stored as a sorted list of patches
+ * that replace ranges of the original with text from an append-only buffer (a piece table).
+ * Everything that is not edited, including comments and formatting, stays as it is. The result
+ * is written out by gathering the untouched ranges and the patches in a single writev.
+ *
+ * Properties are matched by their full name in the first section with the given name,
+ * a NULL section refers to the properties before the first section. New properties are added
+ * after the last property of their section, new sections at the end. Values are written as
+ * they are and must not contain line breaks.
+ */
+typedef struct
+{
+    size_t start;       /* replaced range of the original */
+    size_t len;
+    size_t text;        /* replacement in the edit buffer */
+    size_t text_len;
+} tb_ini_edit_patch;
+
+typedef struct
+{
+    const char* ini;
+    size_t len;
+
+    tb_ini_edit_patch* patches;
+    size_t patch_count;
+    size_t patch_cap;
+
+    char* buf;
+    size_t buf_len;
+    size_t buf_cap;
+} tb_ini_edit;
+
+/* the buffer is not copied and has to outlive the edit */
+void tb_ini_edit_init(tb_ini_edit* edit, const char* ini, size_t len);
+void tb_ini_edit_destroy(tb_ini_edit* edit);
+
+/* sets the value of the property, the property (and its section) is added if it does not exist */
+tb_ini_error tb_ini_edit_set(tb_ini_edit* edit, const char* section, const char* prop, const char* value);
+
+/* removes the line of the property, returns TB_INI_BAD_PROPERTY if it does not exist */
+tb_ini_error tb_ini_edit_remove(tb_ini_edit* edit, const char* section, const char* prop);
+
+/* adds an empty section if it does not exist */
+tb_ini_error tb_ini_edit_add_section(tb_ini_edit* edit, const char* section);
+
+/* size of the edited text */
+size_t tb_ini_edit_size(const tb_ini_edit* edit);
+
+/* copies the edited text into dst (zero terminated, copies at most dst_len bytes) and returns its length */
+size_t tb_ini_edit_render(const tb_ini_edit* edit, char* dst, size_t dst_len);
+
+/*
+ * writes the edited text to a temporary file next to path which then replaces the file,
+ * so readers (and file watchers) never see a partially written file
+ */
+tb_ini_error tb_ini_edit_save(const tb_ini_edit* edit, const char* path);
+
+#endif /* !TB_INI_EDIT_H */
+
+/*
+ * -----------------------------------------------------------------------------
+ * ----| IMPLEMENTATION |-------------------------------------------------------
+ * -----------------------------------------------------------------------------
+ */
+#ifdef TB_INI_EDIT_IMPLEMENTATION
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#define TB_INI_WRITEV
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+#endif
+
+/* ----------------------------| Locating |--------------------------------------------------------- */
+typedef struct
+{
+    const char* text;
+    size_t len;
+
+    const char* section;    /* NULL for the root section */
+    const char* prop;       /* may be NULL to only locate the section */
+
+    int in_section;
+    int section_found;
+    size_t insert;          /* offset after the last property line of the section */
+
+    int prop_found;
+    size_t line_start;
+    size_t line_end;        /* offset after the line break */
+    size_t value_start;
+    size_t value_end;
+} tb_ini_edit_location;
+
+/* returns the offset after the line break following pos */
+static size_t tb_ini_edit_line_end(const char* text, size_t len, size_t pos)
+{
+    const char* line_end = memchr(text + pos, '\n', len - pos);
+    return line_end ? (size_t)(line_end - text) + 1 : len;
+}
+
+static int tb_ini_edit_match(const char* name, size_t len, const char* str)
+{
+    return strlen(str) == len && memcmp(name, str, len) == 0;
+}
+
+static int tb_ini_edit_on_section(void* user, const tb_ini_element* section)
+{
+    tb_ini_edit_location* loc = user;
+
+    /* the section ended */
+    if (loc->in_section) return 1;
+
+    if (loc->section && section->error == TB_INI_OK && tb_ini_edit_match(section->name, section->name_len, loc->section))
+    {
+        loc->in_section = 1;
+        loc->section_found = 1;
+        loc->insert = tb_ini_edit_line_end(loc->text, loc->len, section->start - loc->text);
+    }
+    return 0;
+}
+
+static int tb_ini_edit_on_property(void* user, const tb_ini_element* section, const tb_ini_element* element)
+{
+    tb_ini_edit_location* loc = user;
+    (void)section;
+
+    /* comments and empty lines do not move the insert position */
+    if (!loc->in_section || element->error == TB_INI_BAD_PROPERTY) return 0;
+
+    size_t value_end = element->start + element->len - loc->text;
+    loc->insert = tb_ini_edit_line_end(loc->text, loc->len, value_end);
+
+    if (!loc->prop_found && loc->prop && tb_ini_edit_match(element->name, element->name_len, loc->prop))
+    {
+        const char* line_start = element->name;
+        while (line_start > loc->text && line_start[-1] != '\n') line_start--;
+
+        loc->prop_found = 1;
+        loc->line_start = line_start - loc->text;
+        loc->line_end = loc->insert;
+        loc->value_start = element->start - loc->text;
+        loc->value_end = value_end;
+    }
+    return 0;
+}
+
+static void tb_ini_edit_locate(tb_ini_edit_location* loc, const char* text, size_t len, const char* section, const char* prop)
+{
+    memset(loc, 0, sizeof(tb_ini_edit_location));
+    loc->text = text;
+    loc->len = len;
+    loc->section = section;
+    loc->prop = prop;
+
+    /* the root section always exists */
+    loc->in_section = !section;
+    loc->section_found = !section;
+
+    tb_ini_handler handler = { tb_ini_edit_on_section, tb_ini_edit_on_property, loc };
+    if (len) tb_ini_walk_n(text, len, &handler);
+}
+
+/* ----------------------------| Patches |---------------------------------------------------------- */
+/* returns the index of the first patch not ordered before (start, len) */
+static size_t tb_ini_edit_lower_bound(const tb_ini_edit* edit, size_t start, size_t len)
+{
+    size_t first = 0;
+    size_t last = edit->patch_count;
+    while (first < last)
+    {
+        size_t mid = first + (last - first) / 2;
+        const tb_ini_edit_patch* patch = &edit->patches[mid];
+
+        if (patch->start < start || (patch->start == start && patch->len < len))   first = mid + 1;
+        else                                                                    last = mid;
+    }
+    return first;
+}
+
+static tb_ini_edit_patch* tb_ini_edit_find_patch(tb_ini_edit* edit, size_t start, size_t len)
+{
+    size_t i = tb_ini_edit_lower_bound(edit, start, len);
+    if (i < edit->patch_count && edit->patches[i].start == start && edit->patches[i].len == len) return &edit->patches[i];
+    return NULL;
+}
+
+/* returns the patch replacing (start, len), a new one replaces it with nothing */
+static tb_ini_edit_patch* tb_ini_edit_get_patch(tb_ini_edit* edit, size_t start, size_t len)
+{
+    size_t i = tb_ini_edit_lower_bound(edit, start, len);
+    if (i < edit->patch_count && edit->patches[i].start == start && edit->patches[i].len == len) return &edit->patches[i];
+
+    if (edit->patch_count >= edit->patch_cap)
+    {
+        size_t cap = edit->patch_cap ? edit->patch_cap * 2 : 16;
+        tb_ini_edit_patch* patches = realloc(edit->patches, cap * sizeof(tb_ini_edit_patch));
+        if (!patches) return NULL;
+
+        edit->patches = patches;
+        edit->patch_cap = cap;
+    }
+
+    memmove(&edit->patches[i + 1], &edit->patches[i], (edit->patch_count - i) * sizeof(tb_ini_edit_patch));
+    edit->patch_count++;
+
+    tb_ini_edit_patch* patch = &edit->patches[i];
+    patch->start = start;
+    patch->len = len;
+    patch->text = 0;
+    patch->text_len = 0;
+    return patch;
+}
+
+/* removes the patches replacing parts of [start, end) (insertions stay) */
+static void tb_ini_edit_drop_patches(tb_ini_edit* edit, size_t start, size_t end)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < edit->patch_count; ++i)
+    {
+        tb_ini_edit_patch* patch = &edit->patches[i];
+        if (patch->len > 0 && patch->start >= start && patch->start < end) continue;
+
+        edit->patches[count++] = *patch;
+    }
+    edit->patch_count = count;
+}
+
+/* replaces [from, to) of the patch text with the concatenated parts, the new text is appended to the buffer */
+static tb_ini_error tb_ini_edit_splice(tb_ini_edit* edit, tb_ini_edit_patch* patch, size_t from, size_t to, const char* const* parts, size_t count)
+{
+    size_t len = patch->text_len - (to - from);
+    for (size_t i = 0; i < count; ++i) len += strlen(parts[i]);
+
+    if (edit->buf_len + len > edit->buf_cap)
+    {
+        size_t cap = edit->buf_cap ? edit->buf_cap : 256;
+        while (edit->buf_len + len > cap) cap *= 2;
+
+        char* buf = realloc(edit->buf, cap);
+        if (!buf) return TB_INI_ALLOC_ERROR;
+
+        edit->buf = buf;
+        edit->buf_cap = cap;
+    }
+
+    const char* text = edit->buf + patch->text;
+    char* dst = edit->buf + edit->buf_len;
+
+    memcpy(dst, text, from);
+    dst += from;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t part_len = strlen(parts[i]);
+        memcpy(dst, parts[i], part_len);
+        dst += part_len;
+    }
+
+    memcpy(dst, text + to, patch->text_len - to);
+
+    patch->text = edit->buf_len;
+    patch->text_len = len;
+    edit->buf_len += len;
+    return TB_INI_OK;
+}
+
+/* checks if the output before offset pos of the patch text ends with a line break (or is empty) */
+static int tb_ini_edit_at_line_start(const tb_ini_edit* edit, const tb_ini_edit_patch* patch, size_t pos)
+{
+    if (pos > 0) return edit->buf[patch->text + pos - 1] == '\n';
+    return patch->start == 0 || edit->ini[patch->start - 1] == '\n';
+}
+
+/* sets the property in the text inserted at pos, the section is NULL for the section pos is in */
+static tb_ini_error tb_ini_edit_insert(tb_ini_edit* edit, size_t pos, const char* section, const char* prop, const char* value)
+{
+    tb_ini_edit_patch* patch = tb_ini_edit_get_patch(edit, pos, 0);
+    if (!patch) return TB_INI_ALLOC_ERROR;
+
+    tb_ini_edit_location loc;
+    tb_ini_edit_locate(&loc, edit->buf + patch->text, patch->text_len, section, prop);
+
+    if (loc.prop_found)
+    {
+        const char* parts[] = { value };
+        return tb_ini_edit_splice(edit, patch, loc.value_start, loc.value_end, parts, 1);
+    }
+
+    const char* newline = tb_ini_edit_at_line_start(edit, patch, loc.insert) ? "" : "\n";
+    if (loc.section_found)
+    {
+        const char* parts[] = { newline, prop, " = ", value, "\n" };
+        return tb_ini_edit_splice(edit, patch, loc.insert, loc.insert, parts, 5);
+    }
+
+    /* new sections are separated by an empty line */
+    size_t end = patch->text_len;
+    const char* separator = (pos + end == 0) ? "" : tb_ini_edit_at_line_start(edit, patch, end) ? "\n" : "\n\n";
+
+    const char* parts[] = { separator, "[", section, "]\n", prop, " = ", value, "\n" };
+    return tb_ini_edit_splice(edit, patch, end, end, parts, prop ? 8 : 4);
+}
+
+/* ----------------------------| Output |----------------------------------------------------------- */
+typedef int (*tb_ini_edit_piece_func)(void* user, const char* data, size_t len);
+
+/* calls func for the untouched ranges of the original and the patches in order */
+static int tb_ini_edit_pieces(const tb_ini_edit* edit, tb_ini_edit_piece_func func, void* user)
+{
+    size_t pos = 0;
+    for (size_t i = 0; i < edit->patch_count; ++i)
+    {
+        const tb_ini_edit_patch* patch = &edit->patches[i];
+        if (patch->start > pos && func(user, edit->ini + pos, patch->start - pos) != 0) return 1;
+        if (patch->text_len > 0 && func(user, edit->buf + patch->text, patch->text_len) != 0) return 1;
+
+        pos = patch->start + patch->len;
+    }
+
+    return (edit->len > pos) ? func(user, edit->ini + pos, edit->len - pos) : 0;
+}
+
+typedef struct
+{
+    char* dst;
+    size_t len;
+    size_t max_len;
+} tb_ini_edit_render_state;
+
+static int tb_ini_edit_render_piece(void* user, const char* data, size_t len)
+{
+    tb_ini_edit_render_state* state = user;
+    if (len > state->max_len - state->len) len = state->max_len - state->len;
+
+    memcpy(state->dst + state->len, data, len);
+    state->len += len;
+    return 0;
+}
+
+static int tb_ini_edit_count_piece(void* user, const char* data, size_t len)
+{
+    (void)data;
+    *(size_t*)user += len;
+    return 0;
+}
+
+#ifdef TB_INI_WRITEV
+typedef struct
+{
+    int fd;
+    struct iovec iov[IOV_MAX];
+    int count;
+} tb_ini_edit_write_state;
+
+/* writes all gathered pieces, continuing after partial writes */
+static int tb_ini_edit_flush(tb_ini_edit_write_state* state)
+{
+    struct iovec* iov = state->iov;
+    int count = state->count;
+    state->count = 0;
+
+    while (count > 0)
+    {
+        ssize_t written = writev(state->fd, iov, count);
+        if (written < 0) return 1;
+
+        while (count > 0 && (size_t)written >= iov->iov_len)
+        {
+            written -= iov->iov_len;
+            iov++;
+            count--;
+        }
+
+        if (count > 0)
+        {
+            iov->iov_base = (char*)iov->iov_base + written;
+            iov->iov_len -= written;
+        }
+    }
+    return 0;
+}
+
+static int tb_ini_edit_write_piece(void* user, const char* data, size_t len)
+{
+    tb_ini_edit_write_state* state = user;
+    if (state->count == IOV_MAX && tb_ini_edit_flush(state) != 0) return 1;
+
+    state->iov[state->count].iov_base = (void*)data;
+    state->iov[state->count].iov_len = len;
+    state->count++;
+    return 0;
+}
+#else
+static int tb_ini_edit_write_piece(void* user, const char* data, size_t len)
+{
+    return fwrite(data, 1, len, user) != len;
+}
+#endif
+
+/* ----------------------------| Public API |------------------------------------------------------- */
+void tb_ini_edit_init(tb_ini_edit* edit, const char* ini, size_t len)
+{
+    memset(edit, 0, sizeof(tb_ini_edit));
+    edit->ini = ini;
+    edit->len = len;
+}
+
+void tb_ini_edit_destroy(tb_ini_edit* edit)
+{
+    free(edit->patches);
+    free(edit->buf);
+    memset(edit, 0, sizeof(tb_ini_edit));
+}
+
+tb_ini_error tb_ini_edit_set(tb_ini_edit* edit, const char* section, const char* prop, const char* value)
+{
+    tb_ini_edit_location loc;
+    tb_ini_edit_locate(&loc, edit->ini, edit->len, section, prop);
+
+    if (loc.prop_found)
+    {
+        /* a removed line is replaced with a new one */
+        tb_ini_edit_patch* removed = tb_ini_edit_find_patch(edit, loc.line_start, loc.line_end - loc.line_start);
+        if (removed)
+        {
+            const char* parts[] = { prop, " = ", value, "\n" };
+            return tb_ini_edit_splice(edit, removed, 0, removed->text_len, parts, 4);
+        }
+
+        tb_ini_edit_patch* patch = tb_ini_edit_get_patch(edit, loc.value_start, loc.value_end - loc.value_start);
+        if (!patch) return TB_INI_ALLOC_ERROR;
+
+        const char* parts[] = { value };
+        return tb_ini_edit_splice(edit, patch, 0, patch->text_len, parts, 1);
+    }
+
+    /* new properties of existing sections are inserted after their last property, new sections are appended */
+    if (loc.section_found)  return tb_ini_edit_insert(edit, loc.insert, NULL, prop, value);
+    else                    return tb_ini_edit_insert(edit, edit->len, section, prop, value);
+}
+
+tb_ini_error tb_ini_edit_remove(tb_ini_edit* edit, const char* section, const char* prop)
+{
+    tb_ini_edit_location loc;
+    tb_ini_edit_locate(&loc, edit->ini, edit->len, section, prop);
+
+    if (loc.prop_found)
+    {
+        size_t len = loc.line_end - loc.line_start;
+        tb_ini_edit_patch* patch = tb_ini_edit_find_patch(edit, loc.line_start, len);
+        if (patch)
+        {
+            if (patch->text_len == 0) return TB_INI_BAD_PROPERTY;
+
+            patch->text_len = 0;
+            return TB_INI_OK;
+        }
+
+        /* the line replaces edits of its value */
+        tb_ini_edit_drop_patches(edit, loc.line_start, loc.line_end);
+        return tb_ini_edit_get_patch(edit, loc.line_start, len) ? TB_INI_OK : TB_INI_ALLOC_ERROR;
+    }
+
+    /* look for the property in the inserted text */
+    tb_ini_edit_patch* patch = tb_ini_edit_find_patch(edit, loc.section_found ? loc.insert : edit->len, 0);
+    if (!patch) return TB_INI_BAD_PROPERTY;
+
+    tb_ini_edit_locate(&loc, edit->buf + patch->text, patch->text_len, loc.section_found ? NULL : section, prop);
+    if (!loc.prop_found) return TB_INI_BAD_PROPERTY;
+
+    return tb_ini_edit_splice(edit, patch, loc.line_start, loc.line_end, NULL, 0);
+}
+
+tb_ini_error tb_ini_edit_add_section(tb_ini_edit* edit, const char* section)
+{
+    tb_ini_edit_location loc;
+    tb_ini_edit_locate(&loc, edit->ini, edit->len, section, NULL);
+    if (loc.section_found) return TB_INI_OK;
+
+    tb_ini_edit_patch* patch = tb_ini_edit_find_patch(edit, edit->len, 0);
+    if (patch)
+    {
+        tb_ini_edit_locate(&loc, edit->buf + patch->text, patch->text_len, section, NULL);
+        if (loc.section_found) return TB_INI_OK;
+    }
+
+    return tb_ini_edit_insert(edit, edit->len, section, NULL, NULL);
+}
+
+size_t tb_ini_edit_size(const tb_ini_edit* edit)
+{
+    size_t size = 0;
+    tb_ini_edit_pieces(edit, tb_ini_edit_count_piece, &size);
+    return size;
+}
+
+size_t tb_ini_edit_render(const tb_ini_edit* edit, char* dst, size_t dst_len)
+{
+    if (dst_len == 0) return 0;
+
+    tb_ini_edit_render_state state = { dst, 0, dst_len - 1 };
+    tb_ini_edit_pieces(edit, tb_ini_edit_render_piece, &state);
+
+    dst[state.len] = '\0';
+    return state.len;
+}
+
+tb_ini_error tb_ini_edit_save(const tb_ini_edit* edit, const char* path)
+{
+    size_t path_len = strlen(path);
+    char* tmp_path = malloc(path_len + 5);
+    if (!tmp_path) return TB_INI_ALLOC_ERROR;
+
+    memcpy(tmp_path, path, path_len);
+    memcpy(tmp_path + path_len, ".tmp", 5);
+
+    int failed = 1;
+#ifdef TB_INI_WRITEV
+    /* keep the permissions of the file that gets replaced */
+    struct stat st;
+    mode_t mode = (stat(path, &st) == 0) ? (st.st_mode & 0777) : 0644;
+
+    tb_ini_edit_write_state* state = malloc(sizeof(tb_ini_edit_write_state));
+    int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, mode);
+    if (state && fd >= 0)
+    {
+        state->fd = fd;
+        state->count = 0;
+        failed = tb_ini_edit_pieces(edit, tb_ini_edit_write_piece, state) || tb_ini_edit_flush(state);
+    }
+
+    if (fd >= 0 && close(fd) != 0) failed = 1;
+    free(state);
+
+    if (!failed) failed = rename(tmp_path, path) != 0;
+#else
+    FILE* file = fopen(tmp_path, "wb");
+    if (file)
+    {
+        failed = tb_ini_edit_pieces(edit, tb_ini_edit_write_piece, file);
+        if (fclose(file) != 0) failed = 1;
+    }
+
+    /* rename does not replace existing files everywhere */
+    if (!failed)
+    {
+        remove(path);
+        failed = rename(tmp_path, path) != 0;
+    }
+#endif
+
+    if (failed) remove(tmp_path);
+    free(tmp_path);
+    return failed ? TB_INI_IO_ERROR : TB_INI_OK;
+}
+#endif /* !TB_INI_EDIT_IMPLEMENTATION */
+
+/*
+MIT License
+
+Copyright (c) 2020 oliverjakobs
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
\ No newline at end of file
@@ -0,0 +1,607 @@
+#ifndef TB_INI_SNAPSHOT_H
+#define TB_INI_SNAPSHOT_H
+
+#include "tb_ini.h"
+
+/*
+ * Compiled binary snapshot of an ini file.
+ * The snapshot contains sorted section and property tables, pre-parsed numbers and a
+ * string pool. It uses no pointers, so it can be written to a file as is and later be
+ * used directly from a (read-only) memory mapping or any 8 byte aligned buffer.
+ * Lookups are binary searches instead of a scan of the text. As with tb_ini_query the
+ * first occurrence of a section or property wins, a NULL section refers to the
+ * properties before the first section.
+ */
+#define TB_INI_SNAPSHOT_VERSION 1
+
+typedef struct tb_ini_snapshot_header tb_ini_snapshot_header;
+
+typedef struct
+{
+    const tb_ini_snapshot_header* header;
+    const char* data;
+    size_t size;
+} tb_ini_snapshot;
+
+/*
+ * Compiles the ini into a snapshot.
+ * mtime is stored for tb_ini_snapshot_stale and may be 0 if it is not used.
+ * Returns a malloc'd buffer of *size bytes or NULL on failure (the reason is written to error if not NULL).
+ */
+void* tb_ini_snapshot_compile(const char* ini, size_t len, uint64_t mtime, size_t* size, tb_ini_error* error);
+
+/* Checks the header and table bounds of the snapshot data. Does not copy the data. */
+tb_ini_error tb_ini_snapshot_open(tb_ini_snapshot* snapshot, const void* data, size_t size);
+
+/*
+ * Returns 1 if the snapshot is out of date.
+ * If ini is not NULL the content of the source is compared by length and hash (mtime is not
+ * used), else the snapshot is stale if mtime differs from the stored one.
+ */
+int tb_ini_snapshot_stale(const tb_ini_snapshot* snapshot, uint64_t mtime, const char* ini, size_t len);
+
+/*
+ * Works like tb_ini_query, the element points into the string pool (values are zero terminated).
+ * If prop is NULL the section is returned with len being the number of properties.
+ */
+tb_ini_error tb_ini_snapshot_query(const tb_ini_snapshot* snapshot, const char* section, const char* prop, tb_ini_element* element);
+
+/* utility functions to get pre-parsed values */
+int     tb_ini_snapshot_bool(const tb_ini_snapshot* snapshot, const char* section, const char* prop, int def);
+int     tb_ini_snapshot_int(const tb_ini_snapshot* snapshot, const char* section, const char* prop, int def);
+int64_t tb_ini_snapshot_int64(const tb_ini_snapshot* snapshot, const char* section, const char* prop, int64_t def);
+float   tb_ini_snapshot_float(const tb_ini_snapshot* snapshot, const char* section, const char* prop, float def);
+double  tb_ini_snapshot_double(const tb_ini_snapshot* snapshot, const char* section, const char* prop, double def);
+size_t  tb_ini_snapshot_string(const tb_ini_snapshot* snapshot, const char* section, const char* prop, char* dst, size_t dst_len);
+
+/* 64 bit FNV-1a hash used to detect changes of the source */
+uint64_t tb_ini_snapshot_hash(const char* data, size_t len);
+
+#endif /* !TB_INI_SNAPSHOT_H */
+
+/*
+ * -----------------------------------------------------------------------------
+ * ----| IMPLEMENTATION |-------------------------------------------------------
+ * -----------------------------------------------------------------------------
+ */
+#ifdef TB_INI_SNAPSHOT_IMPLEMENTATION
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+
+#define TB_INI_SNAPSHOT_MAGIC       "TBINISNP"
+#define TB_INI_SNAPSHOT_BYTE_ORDER  0x01020304
+
+/* flags for pre-parsed values */
+#define TB_INI_SNAPSHOT_INT         (1 << 0)
+#define TB_INI_SNAPSHOT_DOUBLE      (1 << 1)
+#define TB_INI_SNAPSHOT_TRUE        (1 << 2)
+
+/* all offsets are relative to the start of the snapshot */
+struct tb_ini_snapshot_header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t size;
+    uint64_t source_len;
+    uint64_t source_hash;
+    uint64_t source_mtime;
+    uint64_t section_count;
+    uint64_t prop_count;
+    uint64_t sections;
+    uint64_t props;
+    uint64_t strings;
+};
+
+typedef struct
+{
+    uint64_t name;
+    uint64_t name_len;
+    uint64_t first_prop;
+    uint64_t prop_count;
+} tb_ini_snapshot_section;
+
+typedef struct
+{
+    uint64_t name;
+    uint64_t value;
+    uint32_t name_len;
+    uint32_t value_len;
+    uint32_t flags;
+    uint32_t error;
+    int64_t i;
+    double d;
+} tb_ini_snapshot_prop;
+
+/* ----------------------------| Compiler |--------------------------------------------------------- */
+typedef struct
+{
+    const char* name;
+    size_t name_len;
+    size_t index;   /* position in file order, becomes the position in the table after sorting */
+} tb_ini_build_section;
+
+typedef struct
+{
+    size_t section;
+    const char* name;
+    size_t name_len;
+    const char* value;
+    size_t value_len;
+    tb_ini_error error;
+    size_t index;   /* position in file order */
+} tb_ini_build_prop;
+
+typedef struct
+{
+    tb_ini_build_section* sections;
+    size_t section_count;
+    size_t section_cap;
+
+    tb_ini_build_prop* props;
+    size_t prop_count;
+    size_t prop_cap;
+
+    size_t current;     /* current section or SIZE_MAX after a malformed header */
+    tb_ini_error error;
+} tb_ini_build;
+
+static int tb_ini_snapshot_cmp_name(const char* name, size_t len, const char* str, size_t str_len)
+{
+    int cmp = memcmp(name, str, len < str_len ? len : str_len);
+    return cmp ? cmp : (len > str_len) - (len < str_len);
+}
+
+static void* tb_ini_build_grow(void* buf, size_t* cap, size_t count, size_t elem_size)
+{
+    if (count < *cap) return buf;
+
+    size_t new_cap = *cap ? *cap * 2 : 64;
+    void* grown = realloc(buf, new_cap * elem_size);
+    if (grown) *cap = new_cap;
+    return grown;
+}
+
+static int tb_ini_build_push_section(tb_ini_build* build, const char* name, size_t name_len)
+{
+    tb_ini_build_section* sections = tb_ini_build_grow(build->sections, &build->section_cap, build->section_count, sizeof(tb_ini_build_section));
+    if (!sections)
+    {
+        build->error = TB_INI_ALLOC_ERROR;
+        return 1;
+    }
+
+    build->sections = sections;
+    build->current = build->section_count++;
+
+    tb_ini_build_section* section = &build->sections[build->current];
+    section->name = name;
+    section->name_len = name_len;
+    section->index = build->current;
+    return 0;
+}
+
+static int tb_ini_build_on_section(void* user, const tb_ini_element* section)
+{
+    tb_ini_build* build = user;
+    if (section->error != TB_INI_OK)
+    {
+        build->current = SIZE_MAX;
+        return 0;
+    }
+    return tb_ini_build_push_section(build, section->name, section->name_len);
+}
+
+static int tb_ini_build_on_property(void* user, const tb_ini_element* section, const tb_ini_element* element)
+{
+    tb_ini_build* build = user;
+    (void)section;
+
+    /* lines without a key value pair and properties of malformed sections are not stored */
+    if (build->current == SIZE_MAX || element->error == TB_INI_BAD_PROPERTY) return 0;
+
+    tb_ini_build_prop* props = tb_ini_build_grow(build->props, &build->prop_cap, build->prop_count, sizeof(tb_ini_build_prop));
+    if (!props)
+    {
+        build->error = TB_INI_ALLOC_ERROR;
+        return 1;
+    }
+    build->props = props;
+
+    tb_ini_build_prop* prop = &build->props[build->prop_count];
+    prop->section = build->current;
+    prop->name = element->name;
+    prop->name_len = element->name_len;
+    prop->value = element->start;
+    prop->value_len = element->len;
+    prop->error = element->error;
+    prop->index = build->prop_count++;
+    return 0;
+}
+
+static int tb_ini_build_section_cmp(const void* left, const void* right)
+{
+    const tb_ini_build_section* l = left;
+    const tb_ini_build_section* r = right;
+
+    int cmp = tb_ini_snapshot_cmp_name(l->name, l->name_len, r->name, r->name_len);
+    return cmp ? cmp : (l->index > r->index) - (l->index < r->index);
+}
+
+static int tb_ini_build_prop_cmp(const void* left, const void* right)
+{
+    const tb_ini_build_prop* l = left;
+    const tb_ini_build_prop* r = right;
+
+    if (l->section != r->section) return (l->section > r->section) - (l->section < r->section);
+
+    int cmp = tb_ini_snapshot_cmp_name(l->name, l->name_len, r->name, r->name_len);
+    return cmp ? cmp : (l->index > r->index) - (l->index < r->index);
+}
+
+static uint64_t tb_ini_snapshot_align(uint64_t offset) { return (offset + 7) & ~(uint64_t)7; }
+
+/* copies the string to the pool and returns its offset */
+static uint64_t tb_ini_snapshot_pool(char* data, uint64_t* pool, const char* str, size_t len)
+{
+    uint64_t offset = *pool;
+    memcpy(data + offset, str, len);
+    data[offset + len] = '\0';
+    *pool += len + 1;
+    return offset;
+}
+
+static void* tb_ini_snapshot_emit(tb_ini_build* build, const char* ini, size_t len, uint64_t mtime, size_t* size)
+{
+    /* sort sections by name (stable by file order) and drop duplicates, mapping them to SIZE_MAX */
+    size_t* section_map = malloc((build->section_count + 1) * sizeof(size_t));
+    if (!section_map) return NULL;
+
+    if (build->section_count > 1) qsort(build->sections, build->section_count, sizeof(tb_ini_build_section), tb_ini_build_section_cmp);
+
+    size_t section_count = 0;
+    for (size_t i = 0; i < build->section_count; ++i)
+    {
+        tb_ini_build_section* section = &build->sections[i];
+        int duplicate = section_count > 0 && tb_ini_snapshot_cmp_name(build->sections[section_count - 1].name, build->sections[section_count - 1].name_len, section->name, section->name_len) == 0;
+
+        section_map[section->index] = duplicate ? SIZE_MAX : section_count;
+        if (!duplicate) build->sections[section_count++] = *section;
+    }
+
+    /* map properties to the sorted sections, sort them by (section, name, file order) and drop duplicates */
+    size_t prop_count = 0;
+    for (size_t i = 0; i < build->prop_count; ++i)
+    {
+        tb_ini_build_prop prop = build->props[i];
+        prop.section = section_map[prop.section];
+        if (prop.section != SIZE_MAX) build->props[prop_count++] = prop;
+    }
+    free(section_map);
+
+    if (prop_count > 1) qsort(build->props, prop_count, sizeof(tb_ini_build_prop), tb_ini_build_prop_cmp);
+
+    size_t unique = 0;
+    uint64_t pool_size = 0;
+    for (size_t i = 0; i < prop_count; ++i)
+    {
+        tb_ini_build_prop* prop = &build->props[i];
+        if (unique > 0 && build->props[unique - 1].section == prop->section
+            && tb_ini_snapshot_cmp_name(build->props[unique - 1].name, build->props[unique - 1].name_len, prop->name, prop->name_len) == 0) continue;
+
+        build->props[unique++] = *prop;
+        pool_size += prop->name_len + prop->value_len + 2;
+    }
+    prop_count = unique;
+
+    for (size_t i = 0; i < section_count; ++i)
+        pool_size += build->sections[i].name_len + 1;
+
+    /* layout: header | sections | props | string pool */
+    uint64_t sections_offset = tb_ini_snapshot_align(sizeof(tb_ini_snapshot_header));
+    uint64_t props_offset = sections_offset + section_count * sizeof(tb_ini_snapshot_section);
+    uint64_t strings_offset = props_offset + prop_count * sizeof(tb_ini_snapshot_prop);
+    uint64_t total = tb_ini_snapshot_align(strings_offset + pool_size);
+
+    char* data = calloc(1, total);
+    if (!data) return NULL;
+
+    tb_ini_snapshot_header* header = (tb_ini_snapshot_header*)data;
+    memcpy(header->magic, TB_INI_SNAPSHOT_MAGIC, sizeof(header->magic));
+    header->version = TB_INI_SNAPSHOT_VERSION;
+    header->byte_order = TB_INI_SNAPSHOT_BYTE_ORDER;
+    header->size = total;
+    header->source_len = len;
+    header->source_hash = tb_ini_snapshot_hash(ini, len);
+    header->source_mtime = mtime;
+    header->section_count = section_count;
+    header->prop_count = prop_count;
+    header->sections = sections_offset;
+    header->props = props_offset;
+    header->strings = strings_offset;
+
+    tb_ini_snapshot_section* sections = (tb_ini_snapshot_section*)(data + sections_offset);
+    tb_ini_snapshot_prop* props = (tb_ini_snapshot_prop*)(data + props_offset);
+    uint64_t pool = strings_offset;
+
+    for (size_t i = 0; i < section_count; ++i)
+    {
+        sections[i].name = tb_ini_snapshot_pool(data, &pool, build->sections[i].name, build->sections[i].name_len);
+        sections[i].name_len = build->sections[i].name_len;
+    }
+
+    for (size_t i = 0; i < prop_count; ++i)
+    {
+        tb_ini_build_prop* src = &build->props[i];
+        tb_ini_snapshot_prop* prop = &props[i];
+
+        if (sections[src->section].prop_count++ == 0) sections[src->section].first_prop = i;
+
+        prop->name = tb_ini_snapshot_pool(data, &pool, src->name, src->name_len);
+        prop->name_len = (uint32_t)src->name_len;
+        prop->value = tb_ini_snapshot_pool(data, &pool, src->value ? src->value : "", src->value_len);
+        prop->value_len = (uint32_t)src->value_len;
+        prop->error = src->error;
+
+        /* pre-parse the value */
+        tb_ini_element element = { 0 };
+        element.start = data + prop->value;
+        element.len = prop->value_len;
+
+        if (tb_ini_element_to_int64(&element, &prop->i) == TB_INI_OK)  prop->flags |= TB_INI_SNAPSHOT_INT;
+        if (tb_ini_element_to_double(&element, &prop->d) == TB_INI_OK) prop->flags |= TB_INI_SNAPSHOT_DOUBLE;
+        if (tb_ini_element_to_bool(&element))                          prop->flags |= TB_INI_SNAPSHOT_TRUE;
+    }
+
+    *size = total;
+    return data;
+}
+
+void* tb_ini_snapshot_compile(const char* ini, size_t len, uint64_t mtime, size_t* size, tb_ini_error* error)
+{
+    tb_ini_build build = { 0 };
+    build.error = TB_INI_OK;
+
+    tb_ini_handler handler = { tb_ini_build_on_section, tb_ini_build_on_property, &build };
+
+    /* the properties before the first section belong to the unnamed root section */
+    void* data = NULL;
+    if (tb_ini_build_push_section(&build, "", 0) == 0)
+    {
+        tb_ini_walk_n(ini, len, &handler);
+        if (build.error == TB_INI_OK)
+        {
+            data = tb_ini_snapshot_emit(&build, ini, len, mtime, size);
+            if (!data) build.error = TB_INI_ALLOC_ERROR;
+        }
+    }
+
+    free(build.sections);
+    free(build.props);
+
+    if (error) *error = build.error;
+    return data;
+}
+
+/* ----------------------------| Queries |---------------------------------------------------------- */
+tb_ini_error tb_ini_snapshot_open(tb_ini_snapshot* snapshot, const void* data, size_t size)
+{
+    const tb_ini_snapshot_header* header = data;
+    if (!data || size < sizeof(tb_ini_snapshot_header) || ((uintptr_t)data & 7)) return TB_INI_BAD_VALUE;
+
+    if (memcmp(header->magic, TB_INI_SNAPSHOT_MAGIC, sizeof(header->magic)) != 0
+        || header->version != TB_INI_SNAPSHOT_VERSION
+        || header->byte_order != TB_INI_SNAPSHOT_BYTE_ORDER
+        || header->size > size) return TB_INI_BAD_VALUE;
+
+    /* tables have to be inside the snapshot */
+    if (header->sections > header->size || header->section_count > (header->size - header->sections) / sizeof(tb_ini_snapshot_section)
+        || header->props > header->size || header->prop_count > (header->size - header->props) / sizeof(tb_ini_snapshot_prop)
+        || header->strings > header->size) return TB_INI_BAD_VALUE;
+
+    snapshot->header = header;
+    snapshot->data = data;
+    snapshot->size = (size_t)header->size;
+    return TB_INI_OK;
+}
+
+int tb_ini_snapshot_stale(const tb_ini_snapshot* snapshot, uint64_t mtime, const char* ini, size_t len)
+{
+    const tb_ini_snapshot_header* header = snapshot->header;
+
+    /* without the source only the mtime can be compared */
+    if (!ini) return mtime != header->source_mtime;
+
+    /* a matching mtime is not enough, it can be 0 or miss edits within one timestamp tick */
+    return len != header->source_len || tb_ini_snapshot_hash(ini, len) != header->source_hash;
+}
+
+/* returns the string at offset or NULL if it is not inside the snapshot */
+static const char* tb_ini_snapshot_str(const tb_ini_snapshot* snapshot, uint64_t offset, uint64_t len)
+{
+    return (offset >= snapshot->header->strings && offset + len < snapshot->size) ? snapshot->data + offset : NULL;
+}
+
+static const tb_ini_snapshot_section* tb_ini_snapshot_find_section(const tb_ini_snapshot* snapshot, const char* name)
+{
+    const tb_ini_snapshot_section* sections = (const tb_ini_snapshot_section*)(snapshot->data + snapshot->header->sections);
+    if (!name) name = "";
+
+    size_t len = strlen(name);
+
+    size_t first = 0;
+    size_t last = (size_t)snapshot->header->section_count;
+    while (first < last)
+    {
+        size_t mid = first + (last - first) / 2;
+
+        const char* str = tb_ini_snapshot_str(snapshot, sections[mid].name, sections[mid].name_len);
+        if (!str) return NULL;
+
+        int cmp = tb_ini_snapshot_cmp_name(str, (size_t)sections[mid].name_len, name, len);
+        if (cmp == 0) return &sections[mid];
+
+        if (cmp < 0)    first = mid + 1;
+        else            last = mid;
+    }
+    return NULL;
+}
+
+static const tb_ini_snapshot_prop* tb_ini_snapshot_find_prop(const tb_ini_snapshot* snapshot, const tb_ini_snapshot_section* section, const char* name)
+{
+    const tb_ini_snapshot_prop* props = (const tb_ini_snapshot_prop*)(snapshot->data + snapshot->header->props);
+    size_t len = strlen(name);
+
+    if (section->first_prop + section->prop_count > snapshot->header->prop_count) return NULL;
+
+    size_t first = (size_t)section->first_prop;
+    size_t last = first + (size_t)section->prop_count;
+    while (first < last)
+    {
+        size_t mid = first + (last - first) / 2;
+
+        const char* str = tb_ini_snapshot_str(snapshot, props[mid].name, props[mid].name_len);
+        if (!str) return NULL;
+
+        int cmp = tb_ini_snapshot_cmp_name(str, props[mid].name_len, name, len);
+        if (cmp == 0) return &props[mid];
+
+        if (cmp < 0)    first = mid + 1;
+        else            last = mid;
+    }
+    return NULL;
+}
+
+/* returns the property or NULL and sets the error */
+static const tb_ini_snapshot_prop* tb_ini_snapshot_lookup(const tb_ini_snapshot* snapshot, const char* section, const char* prop, tb_ini_error* error)
+{
+    const tb_ini_snapshot_section* s = tb_ini_snapshot_find_section(snapshot, section);
+    if (!s)
+    {
+        *error = TB_INI_BAD_SECTION;
+        return NULL;
+    }
+
+    const tb_ini_snapshot_prop* p = tb_ini_snapshot_find_prop(snapshot, s, prop);
+    *error = p ? (tb_ini_error)p->error : TB_INI_BAD_PROPERTY;
+    return p;
+}
+
+tb_ini_error tb_ini_snapshot_query(const tb_ini_snapshot* snapshot, const char* section, const char* prop, tb_ini_element* element)
+{
+    element->name = NULL;
+    element->name_len = 0;
+    element->start = NULL;
+    element->len = 0;
+
+    if (!prop)
+    {
+        const tb_ini_snapshot_section* s = tb_ini_snapshot_find_section(snapshot, section);
+        element->error = s ? TB_INI_OK : TB_INI_BAD_SECTION;
+        if (s)
+        {
+            element->name = snapshot->data + s->name;
+            element->name_len = (size_t)s->name_len;
+            element->len = (size_t)s->prop_count;
+        }
+        return element->error;
+    }
+
+    const tb_ini_snapshot_prop* p = tb_ini_snapshot_lookup(snapshot, section, prop, &element->error);
+    if (p)
+    {
+        element->name = snapshot->data + p->name;
+        element->name_len = p->name_len;
+        element->start = tb_ini_snapshot_str(snapshot, p->value, p->value_len);
+        element->len = element->start ? p->value_len : 0;
+    }
+    return element->error;
+}
+
+int tb_ini_snapshot_bool(const tb_ini_snapshot* snapshot, const char* section, const char* prop, int def)
+{
+    tb_ini_error error;
+    const tb_ini_snapshot_prop* p = tb_ini_snapshot_lookup(snapshot, section, prop, &error);
+
+    return (error == TB_INI_OK) ? (p->flags & TB_INI_SNAPSHOT_TRUE) != 0 : def;
+}
+
+int tb_ini_snapshot_int(const tb_ini_snapshot* snapshot, const char* section, const char* prop, int def)
+{
+    int64_t value = tb_ini_snapshot_int64(snapshot, section, prop, def);
+    return (value >= INT_MIN && value <= INT_MAX) ? (int)value : def;
+}
+
+int64_t tb_ini_snapshot_int64(const tb_ini_snapshot* snapshot, const char* section, const char* prop, int64_t def)
+{
+    tb_ini_error error;
+    const tb_ini_snapshot_prop* p = tb_ini_snapshot_lookup(snapshot, section, prop, &error);
+
+    return (error == TB_INI_OK && (p->flags & TB_INI_SNAPSHOT_INT)) ? p->i : def;
+}
+
+float tb_ini_snapshot_float(const tb_ini_snapshot* snapshot, const char* section, const char* prop, float def)
+{
+    double d = tb_ini_snapshot_double(snapshot, section, prop, def);
+
+    /* finite values beyond the range of float are out of range, like in tb_ini_float */
+    return (!isinf(d) && (d > FLT_MAX || d < -FLT_MAX)) ? def : (float)d;
+}
+
+double tb_ini_snapshot_double(const tb_ini_snapshot* snapshot, const char* section, const char* prop, double def)
+{
+    tb_ini_error error;
+    const tb_ini_snapshot_prop* p = tb_ini_snapshot_lookup(snapshot, section, prop, &error);
+
+    return (error == TB_INI_OK && (p->flags & TB_INI_SNAPSHOT_DOUBLE)) ? p->d : def;
+}
+
+size_t tb_ini_snapshot_string(const tb_ini_snapshot* snapshot, const char* section, const char* prop, char* dst, size_t dst_len)
+{
+    tb_ini_element element;
+    if (tb_ini_snapshot_query(snapshot, section, prop, &element) == TB_INI_OK && element.start)
+        return tb_ini_element_to_string(&element, dst, dst_len);
+
+    dst[0] = '\0';
+    return 0;
+}
+
+uint64_t tb_ini_snapshot_hash(const char* data, size_t len)
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    for (size_t i = 0; i < len; ++i)
+    {
+        hash ^= (unsigned char)data[i];
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+#endif /* !TB_INI_SNAPSHOT_IMPLEMENTATION */
+
+/*
+MIT License
+
+Copyright (c) 2020 oliverjakobs
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
\ No newline at end of file
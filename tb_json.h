@@ -0,0 +1,1306 @@
+#ifndef TB_JSON_H
+#define TB_JSON_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * In-place JSON reader.
+ * Like tb_ini this keeps the input as unaltered text and makes queries on it directly, elements
+ * point into the input buffer. The input does not need to be zero terminated and is never
+ * written to, no byte at or after json + len is read.
+ *
+ * Queries only look at the parts of the document they pass through: skipped values are scanned
+ * for strings and brackets but not checked further, returned strings, numbers and literals are
+ * checked completely. Use tb_json_validate to check a whole document.
+ */
+#define TB_JSON_MAX_DEPTH   512
+
+typedef enum
+{
+    TB_JSON_OK,
+    TB_JSON_BAD_PATH,
+    TB_JSON_BAD_SYNTAX,
+    TB_JSON_BAD_TYPE,
+    TB_JSON_NOT_FOUND,
+    TB_JSON_OUT_OF_RANGE,
+    TB_JSON_ALLOC_ERROR
+} tb_json_error;
+
+typedef enum
+{
+    TB_JSON_NULL,
+    TB_JSON_BOOL,
+    TB_JSON_NUMBER,
+    TB_JSON_STRING,
+    TB_JSON_ARRAY,
+    TB_JSON_OBJECT
+} tb_json_type;
+
+typedef struct
+{
+    const char* name;   /* key of object members (without quotes, escapes are not decoded), else NULL */
+    size_t name_len;
+    const char* start;  /* strings without quotes, arrays and objects including their brackets */
+    size_t len;         /* bytelen of value */
+    tb_json_type type;
+    tb_json_error error;
+} tb_json_element;
+
+/*
+ * path query
+ * a path is a list of object keys separated by '.' and array indices in brackets, e.g.
+ * "servers[2].ports[0]". keys are compared with the raw (escaped) key text and can not contain
+ * '.' or '['. an empty or NULL path refers to the root value, if the object has duplicate
+ * keys the first one is used. to query relative to an element pass its start and len.
+ * returns a pointer into the json after the queried value or NULL if it is not found
+ * (element->error is set in both cases)
+ */
+const char* tb_json_query(const char* json, size_t len, const char* path, tb_json_element* element);
+
+/*
+ * steps over the values of an array or the members of an object
+ * stream starts at the element (start of an array or object element) and is the returned
+ * cursor afterwards, returns NULL if the closing bracket is reached (element->error is
+ * TB_JSON_OK) or on error:
+ *
+ *  const char* cursor = array.start;
+ *  while ((cursor = tb_json_step(cursor, array.start + array.len - cursor, &value))) ...
+ */
+const char* tb_json_step(const char* stream, size_t len, tb_json_element* element);
+
+/* returns the number of values of an array or members of an object (0 on error) */
+size_t tb_json_count(const tb_json_element* element);
+
+/*
+ * checked conversion of elements, returns TB_JSON_BAD_TYPE if the element has another type
+ * integers must not have a fraction or exponent, TB_JSON_OUT_OF_RANGE if they do not fit
+ * numbers the fast path can not round are converted with strtod_l in the C locale, on Linux it
+ * needs _GNU_SOURCE, else strtod with the decimal point of the current locale is used
+ */
+tb_json_error tb_json_element_to_bool(const tb_json_element* element, int* value);
+tb_json_error tb_json_element_to_int64(const tb_json_element* element, int64_t* value);
+tb_json_error tb_json_element_to_double(const tb_json_element* element, double* value);
+
+/*
+ * decodes the escapes of a string element into dst (zero terminated, copies at most dst_len bytes
+ * and never splits a multibyte character), the text of other elements is copied as it is
+ * returns the number of bytes written
+ */
+size_t tb_json_element_to_string(const tb_json_element* element, char* dst, size_t dst_len);
+
+/* utility functions to directly convert a query to different types */
+int     tb_json_bool(const char* json, size_t len, const char* path, int def);
+int     tb_json_int(const char* json, size_t len, const char* path, int def);
+int64_t tb_json_int64(const char* json, size_t len, const char* path, int64_t def);
+double  tb_json_double(const char* json, size_t len, const char* path, double def);
+size_t  tb_json_string(const char* json, size_t len, const char* path, char* dst, size_t dst_len);
+
+/* checks the whole document, element points to the position of the first error */
+tb_json_error tb_json_validate(const char* json, size_t len, tb_json_element* element);
+
+/*
+ * structural index
+ * built in one pass over the document, 64 bytes at a time: bitmaps of quotes and backslashes
+ * give the escaped quotes and the string regions (a prefix xor over the quote bits), the
+ * structural characters ({ } [ ] : ,) outside of strings are collected into a list of offsets.
+ * each opening bracket stores the position of its closing bracket, so skipping a value of any
+ * size is a single step and queries never look at the text between the keys they compare.
+ * the index refers to the json buffer, which has to outlive it. documents are limited to 4 GiB.
+ */
+typedef struct
+{
+    const char* json;
+    size_t len;
+    uint32_t* offsets;  /* offsets of the structural characters in document order */
+    uint32_t* jumps;    /* for opening brackets the position of the closing bracket in offsets */
+    size_t count;
+} tb_json_index;
+
+/* returns TB_JSON_BAD_SYNTAX for unterminated strings or unbalanced brackets */
+tb_json_error tb_json_index_build(tb_json_index* index, const char* json, size_t len);
+void tb_json_index_destroy(tb_json_index* index);
+
+/* same as tb_json_query, returns TB_JSON_OK if the value is found */
+tb_json_error tb_json_index_query(const tb_json_index* index, const char* path, tb_json_element* element);
+
+/* returns a string describing the error */
+const char* tb_json_get_error_desc(tb_json_error error);
+
+#endif /* !TB_JSON_H */
+
+/*
+ * -----------------------------------------------------------------------------
+ * ----| IMPLEMENTATION |-------------------------------------------------------
+ * -----------------------------------------------------------------------------
+ */
+#ifdef TB_JSON_IMPLEMENTATION
+
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <locale.h>
+#include <math.h>
+#include <limits.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*
+ * depths passed to tb_json_parse_value to skip arrays and objects without checking them or
+ * to only read their start (their len then reaches to the end of the input)
+ */
+#define TB_JSON_SKIP            (-1)
+#define TB_JSON_LAZY            (-2)
+
+/* size of the stack buffer numbers are copied to if they have to be converted by strtod */
+#define TB_JSON_NUM_BUF_SIZE    64
+
+#define TB_JSON_IS_WHITESPACE(c)    ((c) == ' ' || (c) == '\t' || (c) == '\n' || (c) == '\r')
+#define TB_JSON_IS_DIGIT(c)         ((c) >= '0' && (c) <= '9')
+
+static const char* tb_json_skip_whitespace(const char* cursor, const char* end)
+{
+    while (cursor < end && TB_JSON_IS_WHITESPACE(*cursor)) cursor++;
+    return cursor;
+}
+
+static const char* tb_json_fail(tb_json_element* element, const char* cursor, tb_json_error error)
+{
+    element->start = cursor;
+    element->len = 0;
+    element->error = error;
+    return NULL;
+}
+
+/* ----------------------------| Parsing |---------------------------------------------------------- */
+static int tb_json_hex4(const char* cursor, const char* end, unsigned* value)
+{
+    if (end - cursor < 4) return 0;
+
+    *value = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        char c = cursor[i];
+        unsigned digit;
+        if (c >= '0' && c <= '9')       digit = c - '0';
+        else if (c >= 'a' && c <= 'f')  digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')  digit = c - 'A' + 10;
+        else return 0;
+
+        *value = (*value << 4) | digit;
+    }
+    return 1;
+}
+
+/* cursor points to the opening quote, returns the position after the closing quote */
+static const char* tb_json_parse_string(const char* cursor, const char* end, tb_json_element* element)
+{
+    const char* start = ++cursor;
+    unsigned codepoint;
+
+    while (cursor < end)
+    {
+        unsigned char c = *cursor;
+        if (c == '"')
+        {
+            element->start = start;
+            element->len = cursor - start;
+            element->type = TB_JSON_STRING;
+            element->error = TB_JSON_OK;
+            return cursor + 1;
+        }
+
+        if (c < 0x20) break;
+
+        if (c == '\\')
+        {
+            if (++cursor == end) break;
+
+            if (*cursor == 'u')
+            {
+                if (!tb_json_hex4(cursor + 1, end, &codepoint)) break;
+                cursor += 4;
+            }
+            else if (!memchr("\"\\/bfnrt", *cursor, 8)) break;
+        }
+        cursor++;
+    }
+    return tb_json_fail(element, cursor, TB_JSON_BAD_SYNTAX);
+}
+
+/* returns the position after the number or NULL if it is malformed */
+static const char* tb_json_parse_number(const char* cursor, const char* end)
+{
+    if (cursor < end && *cursor == '-') cursor++;
+
+    if (cursor < end && *cursor == '0')                             cursor++;
+    else if (cursor < end && *cursor >= '1' && *cursor <= '9')      while (++cursor < end && TB_JSON_IS_DIGIT(*cursor));
+    else                                                            return NULL;
+
+    if (cursor < end && *cursor == '.')
+    {
+        if (++cursor == end || !TB_JSON_IS_DIGIT(*cursor)) return NULL;
+        while (++cursor < end && TB_JSON_IS_DIGIT(*cursor));
+    }
+
+    if (cursor < end && (*cursor == 'e' || *cursor == 'E'))
+    {
+        if (++cursor < end && (*cursor == '-' || *cursor == '+')) cursor++;
+        if (cursor == end || !TB_JSON_IS_DIGIT(*cursor)) return NULL;
+        while (++cursor < end && TB_JSON_IS_DIGIT(*cursor));
+    }
+    return cursor;
+}
+
+/* cursor points to the opening quote, returns the position after the closing quote (or NULL) */
+static const char* tb_json_skip_string(const char* cursor, const char* end)
+{
+    const char* start = cursor++;
+    const char* quote;
+    while ((quote = memchr(cursor, '"', end - cursor)))
+    {
+        /* the quote is escaped if it follows an odd number of backslashes */
+        const char* backslash = quote;
+        while (backslash > start && *(backslash - 1) == '\\') backslash--;
+
+        if (((quote - backslash) & 1) == 0) return quote + 1;
+        cursor = quote + 1;
+    }
+    return NULL;
+}
+
+/* cursor points to the opening bracket, returns the position after the closing bracket (or NULL) */
+static const char* tb_json_skip_container(const char* cursor, const char* end)
+{
+    size_t depth = 0;
+    while (cursor < end)
+    {
+        switch (*cursor)
+        {
+        case '"':
+            if (!(cursor = tb_json_skip_string(cursor, end))) return NULL;
+            continue;
+        case '[':
+        case '{':
+            depth++;
+            break;
+        case ']':
+        case '}':
+            if (--depth == 0) return cursor + 1;
+            break;
+        }
+        cursor++;
+    }
+    return NULL;
+}
+
+static const char* tb_json_next(const char* stream, const char* end, int depth, tb_json_element* element);
+
+/* checks all values of the container at cursor, returns the position after the closing bracket */
+static const char* tb_json_check_container(const char* cursor, const char* end, int depth, tb_json_element* element)
+{
+    if (depth >= TB_JSON_MAX_DEPTH) return tb_json_fail(element, cursor, TB_JSON_OUT_OF_RANGE);
+
+    int object = (*cursor == '{');
+
+    tb_json_element child;
+    while ((cursor = tb_json_next(cursor, end, depth + 1, &child)) && child.start)
+    {
+        /* tb_json_next only finds keys where they can be, but does not know the type of the container */
+        if ((child.name != NULL) != object) return tb_json_fail(element, child.name ? child.name : child.start, TB_JSON_BAD_SYNTAX);
+
+        /* tb_json_next also takes an opening bracket as the start of the container */
+        cursor = tb_json_skip_whitespace(cursor, end);
+        if (cursor == end || (*cursor != ',' && *cursor != ']' && *cursor != '}')) return tb_json_fail(element, cursor, TB_JSON_BAD_SYNTAX);
+    }
+
+    if (!cursor) return tb_json_fail(element, child.start, child.error);
+    if (*cursor != (object ? '}' : ']')) return tb_json_fail(element, cursor, TB_JSON_BAD_SYNTAX);
+
+    return cursor + 1;
+}
+
+/*
+ * parses the value at cursor into element (the name of element is not touched)
+ * containers are checked recursively unless depth is TB_JSON_SKIP or TB_JSON_LAZY
+ * returns the position after the value
+ */
+static const char* tb_json_parse_value(const char* cursor, const char* end, int depth, tb_json_element* element)
+{
+    cursor = tb_json_skip_whitespace(cursor, end);
+    if (cursor == end) return tb_json_fail(element, cursor, TB_JSON_BAD_SYNTAX);
+
+    const char* start = cursor;
+    switch (*cursor)
+    {
+    case '"':
+        if (!(cursor = tb_json_parse_string(cursor, end, element))) return NULL;
+        break;
+    case '[':
+    case '{':
+        if (depth == TB_JSON_LAZY)          cursor = end;
+        else if (depth == TB_JSON_SKIP)     cursor = tb_json_skip_container(cursor, end);
+        else                                cursor = tb_json_check_container(cursor, end, depth, element);
+
+        if (!cursor) return (depth == TB_JSON_SKIP) ? tb_json_fail(element, start, TB_JSON_BAD_SYNTAX) : NULL;
+
+        element->start = start;
+        element->len = cursor - start;
+        element->type = (*start == '[') ? TB_JSON_ARRAY : TB_JSON_OBJECT;
+        element->error = TB_JSON_OK;
+        return cursor;
+    case 't':
+    case 'f':
+    case 'n':
+    {
+        const char* literal = (*cursor == 't') ? "true" : (*cursor == 'f') ? "false" : "null";
+        size_t len = strlen(literal);
+        if ((size_t)(end - cursor) < len || memcmp(cursor, literal, len) != 0) return tb_json_fail(element, start, TB_JSON_BAD_SYNTAX);
+
+        cursor += len;
+        element->type = (*start == 'n') ? TB_JSON_NULL : TB_JSON_BOOL;
+        break;
+    }
+    default:
+        if (!(cursor = tb_json_parse_number(cursor, end))) return tb_json_fail(element, start, TB_JSON_BAD_SYNTAX);
+        element->type = TB_JSON_NUMBER;
+        break;
+    }
+
+    /* scalars have to end with whitespace or a delimiter */
+    if (cursor < end && !TB_JSON_IS_WHITESPACE(*cursor) && *cursor != ',' && *cursor != ']' && *cursor != '}')
+        return tb_json_fail(element, cursor, TB_JSON_BAD_SYNTAX);
+
+    if (element->type != TB_JSON_STRING)
+    {
+        element->start = start;
+        element->len = cursor - start;
+        element->error = TB_JSON_OK;
+    }
+    return cursor;
+}
+
+/*
+ * reads the next value of an array or member of an object, stream points to the opening
+ * bracket or the comma after the previous value. returns the position after the value
+ * or of the closing bracket (element->start is NULL then) or NULL on error
+ */
+static const char* tb_json_next(const char* stream, const char* end, int depth, tb_json_element* element)
+{
+    element->name = NULL;
+    element->name_len = 0;
+
+    const char* cursor = tb_json_skip_whitespace(stream, end);
+    char sep = (cursor < end) ? *cursor : '\0';
+    if (sep == '[' || sep == '{' || sep == ',') cursor = tb_json_skip_whitespace(cursor + 1, end);
+
+    if (cursor < end && (*cursor == ']' || *cursor == '}'))
+    {
+        /* trailing commas are not allowed */
+        if (sep == ',') return tb_json_fail(element, cursor, TB_JSON_BAD_SYNTAX);
+
+        element->start = NULL;
+        element->len = 0;
+        element->error = TB_JSON_OK;
+        return cursor;
+    }
+
+    if (sep != '[' && sep != '{' && sep != ',') return tb_json_fail(element, cursor, TB_JSON_BAD_SYNTAX);
+
+    /* after a comma a string is a key if a colon follows, else it is the value of an array */
+    if (sep != '[' && cursor < end && *cursor == '"')
+    {
+        const char* next = tb_json_parse_string(cursor, end, element);
+        if (!next) return NULL;
+
+        next = tb_json_skip_whitespace(next, end);
+        if (next < end && *next == ':')
+        {
+            element->name = element->start;
+            element->name_len = element->len;
+            return tb_json_parse_value(next + 1, end, depth, element);
+        }
+
+        if (sep == '{') return tb_json_fail(element, next, TB_JSON_BAD_SYNTAX);
+        if (next < end && *next != ',' && *next != ']' && *next != '}') return tb_json_fail(element, next, TB_JSON_BAD_SYNTAX);
+
+        return next;
+    }
+
+    if (sep == '{') return tb_json_fail(element, cursor, TB_JSON_BAD_SYNTAX);
+
+    return tb_json_parse_value(cursor, end, depth, element);
+}
+
+/* ----------------------------| Paths |------------------------------------------------------------ */
+typedef struct
+{
+    const char* key;    /* NULL for array indices */
+    size_t key_len;
+    size_t index;
+} tb_json_segment;
+
+/* reads the next segment of the path, returns 0 at the end of the path and -1 if it is malformed */
+static int tb_json_path_next(const char** path, int first, tb_json_segment* segment)
+{
+    const char* cursor = *path;
+    if (!cursor || *cursor == '\0') return 0;
+
+    if (*cursor == '[')
+    {
+        segment->key = NULL;
+        segment->index = 0;
+
+        if (!TB_JSON_IS_DIGIT(cursor[1])) return -1;
+        cursor++;
+
+        for (; TB_JSON_IS_DIGIT(*cursor); ++cursor)
+        {
+            if (segment->index > (SIZE_MAX - 9) / 10) return -1;
+            segment->index = segment->index * 10 + (*cursor - '0');
+        }
+
+        if (*cursor != ']') return -1;
+        *path = cursor + 1;
+        return 1;
+    }
+
+    if (*cursor == '.')     cursor++;
+    else if (!first)        return -1;
+
+    segment->key = cursor;
+    while (*cursor != '\0' && *cursor != '.' && *cursor != '[') cursor++;
+
+    segment->key_len = cursor - segment->key;
+    if (segment->key_len == 0) return -1;
+
+    *path = cursor;
+    return 1;
+}
+
+/* ----------------------------| Queries |---------------------------------------------------------- */
+const char* tb_json_query(const char* json, size_t len, const char* path, tb_json_element* element)
+{
+    const char* end = json + len;
+
+    element->name = NULL;
+    element->name_len = 0;
+
+    /* containers on the path are not skipped, so the text is only scanned up to the queried value */
+    const char* cursor = tb_json_parse_value(json, end, TB_JSON_LAZY, element);
+
+    tb_json_segment segment;
+    int result;
+    for (int first = 1; cursor && (result = tb_json_path_next(&path, first, &segment)) != 0; first = 0)
+    {
+        if (result < 0) return tb_json_fail(element, NULL, TB_JSON_BAD_PATH);
+
+        tb_json_type type = segment.key ? TB_JSON_OBJECT : TB_JSON_ARRAY;
+        if (element->type != type) return tb_json_fail(element, NULL, TB_JSON_BAD_TYPE);
+
+        const char* container_end = element->start + element->len;
+        const char* stream = element->start;
+        size_t i = 0;
+
+        while ((cursor = tb_json_next(stream, container_end, TB_JSON_LAZY, element)) && element->start)
+        {
+            if (segment.key && element->name_len == segment.key_len && memcmp(element->name, segment.key, segment.key_len) == 0) break;
+            if (!segment.key && i++ == segment.index) break;
+
+            if ((element->type == TB_JSON_ARRAY || element->type == TB_JSON_OBJECT) && !(cursor = tb_json_skip_container(element->start, container_end)))
+                return tb_json_fail(element, element->start, TB_JSON_BAD_SYNTAX);
+
+            stream = cursor;
+        }
+
+        if (cursor && !element->start) return tb_json_fail(element, NULL, TB_JSON_NOT_FOUND);
+    }
+
+    /* the length of the queried container is only known after skipping it */
+    if (cursor && (element->type == TB_JSON_ARRAY || element->type == TB_JSON_OBJECT))
+    {
+        if (!(cursor = tb_json_skip_container(element->start, element->start + element->len)))
+            return tb_json_fail(element, element->start, TB_JSON_BAD_SYNTAX);
+
+        element->len = cursor - element->start;
+    }
+    return cursor;
+}
+
+const char* tb_json_step(const char* stream, size_t len, tb_json_element* element)
+{
+    const char* cursor = tb_json_next(stream, stream + len, TB_JSON_SKIP, element);
+    return (cursor && element->start) ? cursor : NULL;
+}
+
+size_t tb_json_count(const tb_json_element* element)
+{
+    if (element->type != TB_JSON_ARRAY && element->type != TB_JSON_OBJECT) return 0;
+
+    const char* end = element->start + element->len;
+    const char* cursor = element->start;
+
+    tb_json_element value;
+    size_t count = 0;
+    while ((cursor = tb_json_step(cursor, end - cursor, &value))) count++;
+
+    return (value.error == TB_JSON_OK) ? count : 0;
+}
+
+tb_json_error tb_json_validate(const char* json, size_t len, tb_json_element* element)
+{
+    tb_json_element root;
+    if (!element) element = &root;
+
+    element->name = NULL;
+    element->name_len = 0;
+
+    const char* end = json + len;
+    const char* cursor = tb_json_parse_value(json, end, 0, element);
+    if (!cursor) return element->error;
+
+    cursor = tb_json_skip_whitespace(cursor, end);
+    if (cursor != end) tb_json_fail(element, cursor, TB_JSON_BAD_SYNTAX);
+
+    return element->error;
+}
+
+/* ----------------------------| Conversion |------------------------------------------------------- */
+static const double tb_json_pow10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/*
+ * strtod_l with a cached C locale, tb_json stays a standalone header so this is not shared with tb_ini
+ * plain strtod (with the '.' swapped for the current decimal point) is the fallback
+ */
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TB_JSON_STRTOD_L
+typedef _locale_t tb_json_locale;
+#define tb_json_locale_create()     _create_locale(LC_NUMERIC, "C")
+#define tb_json_locale_free(l)      _free_locale(l)
+#define tb_json_locale_load(p)      ((tb_json_locale)_InterlockedCompareExchangePointer((void* volatile*)(p), NULL, NULL))
+#define tb_json_locale_cas(p, l)    (_InterlockedCompareExchangePointer((void* volatile*)(p), (l), NULL) == NULL)
+#define tb_json_strtod_l(s, e, l)   _strtod_l((s), (e), (l))
+#elif (defined(__GLIBC__) && defined(_GNU_SOURCE)) || defined(__APPLE__) || defined(__FreeBSD__)
+#if defined(__APPLE__) || defined(__FreeBSD__)
+#include <xlocale.h>
+#endif
+#define TB_JSON_STRTOD_L
+typedef locale_t tb_json_locale;
+#define tb_json_locale_create()     newlocale(LC_NUMERIC_MASK, "C", (locale_t)0)
+#define tb_json_locale_free(l)      freelocale(l)
+#define tb_json_locale_load(p)      __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define tb_json_locale_cas(p, l)    __atomic_compare_exchange_n((p), &(tb_json_locale){ (locale_t)0 }, (l), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define tb_json_strtod_l(s, e, l)   strtod_l((s), (e), (l))
+#else
+typedef void* tb_json_locale;
+#define tb_json_c_locale()          NULL
+#define tb_json_strtod_l(s, e, l)   strtod((s), (e))
+#endif
+
+#ifdef TB_JSON_STRTOD_L
+static tb_json_locale tb_json_c_locale(void)
+{
+    static tb_json_locale locale;
+
+    tb_json_locale current = tb_json_locale_load(&locale);
+    if (current) return current;
+
+    tb_json_locale created = tb_json_locale_create();
+    if (!created) return created;
+
+    /* another thread may have created one first, only that one is kept */
+    if (tb_json_locale_cas(&locale, created)) return created;
+
+    tb_json_locale_free(created);
+    return tb_json_locale_load(&locale);
+}
+#endif
+
+/* slow path for numbers the fast path can not round correctly */
+static tb_json_error tb_json_strtod(const char* start, size_t len, double* value)
+{
+    tb_json_locale locale = tb_json_c_locale();
+
+    /* the decimal point can be longer than one byte in the current locale */
+    const char* point = locale ? "." : localeconv()->decimal_point;
+    size_t point_len = strlen(point);
+    const char* dot = memchr(start, '.', len);
+    size_t str_len = dot ? len - 1 + point_len : len;
+
+    char buf[TB_JSON_NUM_BUF_SIZE];
+    char* str = (str_len < TB_JSON_NUM_BUF_SIZE) ? buf : malloc(str_len + 1);
+    if (!str) return TB_JSON_ALLOC_ERROR;
+
+    if (dot)
+    {
+        size_t before = (size_t)(dot - start);
+        memcpy(str, start, before);
+        memcpy(str + before, point, point_len);
+        memcpy(str + before + point_len, dot + 1, len - before - 1);
+    }
+    else
+    {
+        memcpy(str, start, len);
+    }
+    str[str_len] = '\0';
+
+    char* end;
+    errno = 0;
+    double result = locale ? tb_json_strtod_l(str, &end, locale) : strtod(str, &end);
+
+    tb_json_error error = TB_JSON_OK;
+    if (end != str + str_len)                                                   error = TB_JSON_BAD_SYNTAX;
+    else if (errno == ERANGE && (result == HUGE_VAL || result == -HUGE_VAL))    error = TB_JSON_OUT_OF_RANGE;
+    else                                                                        *value = result;
+
+    if (str != buf) free(str);
+    return error;
+}
+
+tb_json_error tb_json_element_to_bool(const tb_json_element* element, int* value)
+{
+    if (element->type != TB_JSON_BOOL) return TB_JSON_BAD_TYPE;
+
+    *value = (*element->start == 't');
+    return TB_JSON_OK;
+}
+
+tb_json_error tb_json_element_to_int64(const tb_json_element* element, int64_t* value)
+{
+    if (element->type != TB_JSON_NUMBER) return TB_JSON_BAD_TYPE;
+
+    const char* cursor = element->start;
+    const char* end = cursor + element->len;
+
+    int negative = (*cursor == '-');
+    if (negative) cursor++;
+
+    uint64_t result = 0;
+    for (size_t i = 0; cursor < end; ++cursor, ++i)
+    {
+        if (!TB_JSON_IS_DIGIT(*cursor)) return TB_JSON_BAD_TYPE;
+
+        unsigned digit = *cursor - '0';
+        if (i >= 19 && result > (UINT64_MAX - digit) / 10) return TB_JSON_OUT_OF_RANGE;
+        result = result * 10 + digit;
+    }
+
+    if (result > (negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX)) return TB_JSON_OUT_OF_RANGE;
+
+    *value = negative ? -(int64_t)(result - 1) - 1 : (int64_t)result;
+    return TB_JSON_OK;
+}
+
+tb_json_error tb_json_element_to_double(const tb_json_element* element, double* value)
+{
+    if (element->type != TB_JSON_NUMBER) return TB_JSON_BAD_TYPE;
+
+    const char* cursor = element->start;
+    const char* end = cursor + element->len;
+
+    int negative = (*cursor == '-');
+    if (negative) cursor++;
+
+    /* read up to 19 significant digits into the mantissa, remember if any non-zero digit got dropped */
+    uint64_t mantissa = 0;
+    int64_t exponent = 0;
+    int digits = 0;
+    int truncated = 0;
+
+    for (; cursor < end && TB_JSON_IS_DIGIT(*cursor); ++cursor)
+    {
+        if (digits < 19)    { mantissa = mantissa * 10 + (*cursor - '0'); digits += (mantissa != 0); }
+        else                { exponent++; truncated |= (*cursor != '0'); }
+    }
+
+    if (cursor < end && *cursor == '.')
+    {
+        for (++cursor; cursor < end && TB_JSON_IS_DIGIT(*cursor); ++cursor)
+        {
+            if (digits < 19)    { mantissa = mantissa * 10 + (*cursor - '0'); digits += (mantissa != 0); exponent--; }
+            else                { truncated |= (*cursor != '0'); }
+        }
+    }
+
+    if (cursor < end)
+    {
+        int exp_negative = (*(++cursor) == '-');
+        if (*cursor == '-' || *cursor == '+') cursor++;
+
+        int64_t exp = 0;
+        for (; cursor < end; ++cursor)
+            if (exp < 100000) exp = exp * 10 + (*cursor - '0');
+
+        exponent += exp_negative ? -exp : exp;
+    }
+
+    if (mantissa == 0)
+    {
+        *value = negative ? -0.0 : 0.0;
+        return TB_JSON_OK;
+    }
+
+    /*
+     * fast path (Clinger): if the mantissa and the power of ten are both exactly representable
+     * as a double, a single multiplication or division yields the correctly rounded result
+     */
+    if (!truncated && mantissa <= ((uint64_t)1 << 53) && exponent >= -22 && exponent <= 22)
+    {
+        double result = (double)mantissa;
+        result = (exponent < 0) ? result / tb_json_pow10[-exponent] : result * tb_json_pow10[exponent];
+
+        *value = negative ? -result : result;
+        return TB_JSON_OK;
+    }
+
+    return tb_json_strtod(element->start, element->len, value);
+}
+
+/* writes codepoint as utf-8 into buf and returns the number of bytes */
+static size_t tb_json_utf8(unsigned codepoint, char* buf)
+{
+    if (codepoint < 0x80)
+    {
+        buf[0] = (char)codepoint;
+        return 1;
+    }
+    if (codepoint < 0x800)
+    {
+        buf[0] = (char)(0xc0 | (codepoint >> 6));
+        buf[1] = (char)(0x80 | (codepoint & 0x3f));
+        return 2;
+    }
+    if (codepoint < 0x10000)
+    {
+        buf[0] = (char)(0xe0 | (codepoint >> 12));
+        buf[1] = (char)(0x80 | ((codepoint >> 6) & 0x3f));
+        buf[2] = (char)(0x80 | (codepoint & 0x3f));
+        return 3;
+    }
+    buf[0] = (char)(0xf0 | (codepoint >> 18));
+    buf[1] = (char)(0x80 | ((codepoint >> 12) & 0x3f));
+    buf[2] = (char)(0x80 | ((codepoint >> 6) & 0x3f));
+    buf[3] = (char)(0x80 | (codepoint & 0x3f));
+    return 4;
+}
+
+/* decodes the escape sequence after the backslash at cursor into buf */
+static const char* tb_json_unescape(const char* cursor, const char* end, char* buf, size_t* len)
+{
+    *len = 1;
+    if (++cursor == end)
+    {
+        buf[0] = '\\';
+        return cursor;
+    }
+
+    switch (*cursor)
+    {
+    case 'b': buf[0] = '\b'; break;
+    case 'f': buf[0] = '\f'; break;
+    case 'n': buf[0] = '\n'; break;
+    case 'r': buf[0] = '\r'; break;
+    case 't': buf[0] = '\t'; break;
+    case 'u':
+    {
+        unsigned codepoint, low;
+        if (!tb_json_hex4(cursor + 1, end, &codepoint))
+        {
+            buf[0] = 'u';
+            break;
+        }
+        cursor += 4;
+
+        /* surrogate pairs are combined, unpaired surrogates are replaced by U+FFFD */
+        if (codepoint >= 0xd800 && codepoint <= 0xdbff && end - cursor > 2 && cursor[1] == '\\' && cursor[2] == 'u'
+            && tb_json_hex4(cursor + 3, end, &low) && low >= 0xdc00 && low <= 0xdfff)
+        {
+            codepoint = 0x10000 + ((codepoint - 0xd800) << 10) + (low - 0xdc00);
+            cursor += 6;
+        }
+        else if (codepoint >= 0xd800 && codepoint <= 0xdfff)
+        {
+            codepoint = 0xfffd;
+        }
+
+        *len = tb_json_utf8(codepoint, buf);
+        break;
+    }
+    default: buf[0] = *cursor; break;
+    }
+    return cursor + 1;
+}
+
+size_t tb_json_element_to_string(const tb_json_element* element, char* dst, size_t dst_len)
+{
+    if (!dst_len) return 0;
+
+    const char* cursor = element->start;
+    const char* end = cursor + element->len;
+
+    size_t len = 0;
+    if (element->type != TB_JSON_STRING)
+    {
+        len = (element->len < dst_len) ? element->len : dst_len - 1;
+        memcpy(dst, cursor, len);
+    }
+    else
+    {
+        while (cursor < end)
+        {
+            /* copy everything up to the next escape at once */
+            const char* escape = memchr(cursor, '\\', end - cursor);
+            size_t run = (escape ? escape : end) - cursor;
+            if (len + run >= dst_len) run = dst_len - 1 - len;
+
+            memcpy(dst + len, cursor, run);
+            len += run;
+            cursor += run;
+            if (!escape || cursor != escape) break;
+
+            char buf[4];
+            size_t buf_len;
+            cursor = tb_json_unescape(cursor, end, buf, &buf_len);
+            if (len + buf_len >= dst_len) break;
+
+            memcpy(dst + len, buf, buf_len);
+            len += buf_len;
+        }
+
+        /* do not cut a multibyte character in half */
+        if (cursor < end && len > 0 && (dst[len - 1] & 0x80))
+        {
+            size_t start = len;
+            while (start > 0 && (dst[start - 1] & 0xc0) == 0x80) start--;
+            if (start > 0 && (dst[start - 1] & 0xc0) == 0xc0)
+            {
+                unsigned char lead = dst[start - 1];
+                size_t need = (lead >= 0xf0) ? 4 : (lead >= 0xe0) ? 3 : 2;
+                if (len - (start - 1) < need) len = start - 1;
+            }
+        }
+    }
+
+    dst[len] = '\0';
+    return len;
+}
+
+/* ----------------------------| Utility |---------------------------------------------------------- */
+int tb_json_bool(const char* json, size_t len, const char* path, int def)
+{
+    tb_json_element element;
+    tb_json_query(json, len, path, &element);
+
+    int value;
+    return (element.error == TB_JSON_OK && tb_json_element_to_bool(&element, &value) == TB_JSON_OK) ? value : def;
+}
+
+int tb_json_int(const char* json, size_t len, const char* path, int def)
+{
+    int64_t value = tb_json_int64(json, len, path, def);
+    return (value >= INT_MIN && value <= INT_MAX) ? (int)value : def;
+}
+
+int64_t tb_json_int64(const char* json, size_t len, const char* path, int64_t def)
+{
+    tb_json_element element;
+    tb_json_query(json, len, path, &element);
+
+    int64_t value;
+    return (element.error == TB_JSON_OK && tb_json_element_to_int64(&element, &value) == TB_JSON_OK) ? value : def;
+}
+
+double tb_json_double(const char* json, size_t len, const char* path, double def)
+{
+    tb_json_element element;
+    tb_json_query(json, len, path, &element);
+
+    double value;
+    return (element.error == TB_JSON_OK && tb_json_element_to_double(&element, &value) == TB_JSON_OK) ? value : def;
+}
+
+size_t tb_json_string(const char* json, size_t len, const char* path, char* dst, size_t dst_len)
+{
+    tb_json_element element;
+    tb_json_query(json, len, path, &element);
+
+    if (element.error == TB_JSON_OK) return tb_json_element_to_string(&element, dst, dst_len);
+
+    if (dst_len) dst[0] = '\0';
+    return 0;
+}
+
+/* ----------------------------| Structural index |------------------------------------------------- */
+#if defined(__GNUC__) || defined(__clang__)
+#define TB_JSON_CTZ(x)  __builtin_ctzll(x)
+#else
+static int tb_json_ctz(uint64_t x)
+{
+    int n = 0;
+    while (!(x & 1)) { x >>= 1; n++; }
+    return n;
+}
+#define TB_JSON_CTZ(x)  tb_json_ctz(x)
+#endif
+
+/* bitmaps of one 64 byte block of input, bit i refers to byte i */
+typedef struct
+{
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t structural;
+} tb_json_block;
+
+static void tb_json_classify(const unsigned char* src, tb_json_block* block)
+{
+#ifdef __SSE2__
+    block->quote = block->backslash = block->structural = 0;
+    for (int i = 0; i < 64; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+
+        /* '[' and ']' become '{' and '}' when setting bit 5 */
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        __m128i brackets = _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('}')));
+        __m128i separators = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(',')));
+
+        block->quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('"'))) << i;
+        block->backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))) << i;
+        block->structural |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_or_si128(brackets, separators)) << i;
+    }
+#else
+    block->quote = block->backslash = block->structural = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        switch (src[i])
+        {
+        case '"':   block->quote |= (uint64_t)1 << i; break;
+        case '\\':  block->backslash |= (uint64_t)1 << i; break;
+        case '{': case '}': case '[': case ']': case ':': case ',':
+            block->structural |= (uint64_t)1 << i; break;
+        }
+    }
+#endif
+}
+
+/*
+ * returns the bits of the characters that are escaped by a backslash
+ * a backslash escapes the next character if it ends a sequence of odd length, the sequences are
+ * found by adding the sequence starts to the backslashes and looking at the carries.
+ * carry is 1 if the first character of the next block is escaped.
+ */
+static uint64_t tb_json_escaped(uint64_t backslash, uint64_t* carry)
+{
+    const uint64_t even_bits = 0x5555555555555555ull;
+
+    backslash &= ~*carry;
+    uint64_t follows_escape = (backslash << 1) | *carry;
+
+    uint64_t odd_starts = backslash & ~even_bits & ~follows_escape;
+    uint64_t sequences = odd_starts + backslash;
+    *carry = sequences < odd_starts;
+
+    uint64_t invert = sequences << 1;
+    return (even_bits ^ invert) & follows_escape;
+}
+
+/* bit i is set if an odd number of bits up to i is set, i.e. if byte i is inside a string */
+static uint64_t tb_json_prefix_xor(uint64_t bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+static tb_json_error tb_json_index_scan(tb_json_index* index)
+{
+    size_t cap = index->len / 8 + 64;
+    index->offsets = malloc(cap * sizeof(uint32_t));
+    if (!index->offsets) return TB_JSON_ALLOC_ERROR;
+
+    uint64_t escape_carry = 0;
+    uint64_t string_carry = 0;
+    for (size_t pos = 0; pos < index->len; pos += 64)
+    {
+        const unsigned char* src = (const unsigned char*)index->json + pos;
+
+        /* the last block is padded with spaces */
+        unsigned char tail[64];
+        if (index->len - pos < 64)
+        {
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, src, index->len - pos);
+            src = tail;
+        }
+
+        tb_json_block block;
+        tb_json_classify(src, &block);
+
+        uint64_t quote = block.quote & ~tb_json_escaped(block.backslash, &escape_carry);
+        uint64_t string = tb_json_prefix_xor(quote) ^ string_carry;
+        string_carry = 0 - (string >> 63);
+
+        uint64_t structural = block.structural & ~string;
+
+        if (index->count + 64 > cap)
+        {
+            cap *= 2;
+            uint32_t* offsets = realloc(index->offsets, cap * sizeof(uint32_t));
+            if (!offsets) return TB_JSON_ALLOC_ERROR;
+            index->offsets = offsets;
+        }
+
+        while (structural)
+        {
+            index->offsets[index->count++] = (uint32_t)(pos + TB_JSON_CTZ(structural));
+            structural &= structural - 1;
+        }
+    }
+
+    /* unterminated string */
+    return string_carry ? TB_JSON_BAD_SYNTAX : TB_JSON_OK;
+}
+
+static tb_json_error tb_json_index_match(tb_json_index* index)
+{
+    index->jumps = malloc((index->count + 1) * sizeof(uint32_t));
+    if (!index->jumps) return TB_JSON_ALLOC_ERROR;
+
+    uint32_t stack[TB_JSON_MAX_DEPTH];
+    size_t depth = 0;
+
+    for (size_t i = 0; i < index->count; ++i)
+    {
+        char c = index->json[index->offsets[i]];
+        index->jumps[i] = (uint32_t)i;
+
+        if (c == '[' || c == '{')
+        {
+            if (depth == TB_JSON_MAX_DEPTH) return TB_JSON_OUT_OF_RANGE;
+            stack[depth++] = (uint32_t)i;
+        }
+        else if (c == ']' || c == '}')
+        {
+            /* the closing bracket is two characters after the opening one */
+            if (depth == 0 || index->json[index->offsets[stack[depth - 1]]] + 2 != c) return TB_JSON_BAD_SYNTAX;
+            index->jumps[stack[--depth]] = (uint32_t)i;
+        }
+    }
+    return depth ? TB_JSON_BAD_SYNTAX : TB_JSON_OK;
+}
+
+tb_json_error tb_json_index_build(tb_json_index* index, const char* json, size_t len)
+{
+    index->json = json;
+    index->len = len;
+    index->offsets = NULL;
+    index->jumps = NULL;
+    index->count = 0;
+
+    if (len > UINT32_MAX) return TB_JSON_OUT_OF_RANGE;
+
+    tb_json_error error = tb_json_index_scan(index);
+    if (error == TB_JSON_OK) error = tb_json_index_match(index);
+
+    if (error != TB_JSON_OK) tb_json_index_destroy(index);
+    return error;
+}
+
+void tb_json_index_destroy(tb_json_index* index)
+{
+    free(index->offsets);
+    free(index->jumps);
+    index->offsets = NULL;
+    index->jumps = NULL;
+    index->count = 0;
+}
+
+#define TB_JSON_AT(index, k)    ((index)->json + (index)->offsets[k])
+
+/*
+ * reads the value that ends before the structural k (the text between structural k - 1 and k or
+ * the opening bracket at k), returns the structural after the value or index->count + 1 on error
+ */
+static size_t tb_json_index_value(const tb_json_index* index, size_t k, tb_json_element* element)
+{
+    const char* from = (k == 0) ? index->json : TB_JSON_AT(index, k - 1) + 1;
+    const char* to = (k < index->count) ? TB_JSON_AT(index, k) : index->json + index->len;
+
+    const char* cursor = tb_json_skip_whitespace(from, to);
+    if (cursor == to && k < index->count && (*to == '[' || *to == '{'))
+    {
+        size_t close = index->jumps[k];
+
+        element->start = to;
+        element->len = TB_JSON_AT(index, close) - to + 1;
+        element->type = (*to == '[') ? TB_JSON_ARRAY : TB_JSON_OBJECT;
+        element->error = TB_JSON_OK;
+        return close + 1;
+    }
+
+    cursor = tb_json_parse_value(cursor, to, TB_JSON_SKIP, element);
+    if (!cursor) return index->count + 1;
+
+    cursor = tb_json_skip_whitespace(cursor, to);
+    if (cursor != to)
+    {
+        tb_json_fail(element, cursor, TB_JSON_BAD_SYNTAX);
+        return index->count + 1;
+    }
+    return k;
+}
+
+/* returns the raw key that ends before the colon at k */
+static int tb_json_index_key(const tb_json_index* index, size_t k, const char** key, size_t* key_len)
+{
+    const char* from = tb_json_skip_whitespace(TB_JSON_AT(index, k - 1) + 1, TB_JSON_AT(index, k));
+    const char* to = TB_JSON_AT(index, k);
+    while (to > from && TB_JSON_IS_WHITESPACE(*(to - 1))) to--;
+
+    if (to - from < 2 || *from != '"' || *(to - 1) != '"') return 0;
+
+    *key = from + 1;
+    *key_len = to - from - 2;
+    return 1;
+}
+
+/* skips the value before the structural k and returns the structural after it */
+static size_t tb_json_index_skip(const tb_json_index* index, size_t k)
+{
+    /* a value followed by an opening bracket is invalid, so the bracket starts the value */
+    if (k < index->count && (*TB_JSON_AT(index, k) == '[' || *TB_JSON_AT(index, k) == '{')) return index->jumps[k] + 1;
+    return k;
+}
+
+tb_json_error tb_json_index_query(const tb_json_index* index, const char* path, tb_json_element* element)
+{
+    element->name = NULL;
+    element->name_len = 0;
+
+    /* the opening bracket of the current element is the structural before next */
+    size_t next = tb_json_index_value(index, 0, element);
+    size_t open = 0;
+    if (next > index->count) return element->error;
+
+    tb_json_segment segment;
+    int result;
+    for (int first = 1; (result = tb_json_path_next(&path, first, &segment)) != 0; first = 0)
+    {
+        if (result < 0)
+        {
+            tb_json_fail(element, NULL, TB_JSON_BAD_PATH);
+            break;
+        }
+
+        tb_json_type type = segment.key ? TB_JSON_OBJECT : TB_JSON_ARRAY;
+        if (element->type != type)
+        {
+            tb_json_fail(element, NULL, TB_JSON_BAD_TYPE);
+            break;
+        }
+
+        const char* name = NULL;
+        size_t name_len = 0;
+        size_t k = open + 1;
+        int found = 0;
+
+        if (segment.key)
+        {
+            /* k is the colon after the key of the current member */
+            while (k < index->count && *TB_JSON_AT(index, k) == ':')
+            {
+                if (!tb_json_index_key(index, k, &name, &name_len)) break;
+                if (name_len == segment.key_len && memcmp(name, segment.key, name_len) == 0)
+                {
+                    found = 1;
+                    k++;
+                    break;
+                }
+
+                k = tb_json_index_skip(index, k + 1);
+                if (k >= index->count || *TB_JSON_AT(index, k) != ',') break;
+                k++;
+            }
+        }
+        else
+        {
+            found = 1;
+            for (size_t i = 0; i < segment.index && found; ++i)
+            {
+                k = tb_json_index_skip(index, k);
+                found = (k < index->count && *TB_JSON_AT(index, k) == ',');
+                k++;
+            }
+
+            /* an empty array has only whitespace before its closing bracket */
+            if (found && k == open + 1 && k < index->count && *TB_JSON_AT(index, k) == ']')
+                found = (tb_json_skip_whitespace(TB_JSON_AT(index, open) + 1, TB_JSON_AT(index, k)) != TB_JSON_AT(index, k));
+        }
+
+        if (!found)
+        {
+            tb_json_fail(element, NULL, TB_JSON_NOT_FOUND);
+            break;
+        }
+
+        next = tb_json_index_value(index, k, element);
+        if (next > index->count) break;
+
+        element->name = name;
+        element->name_len = name_len;
+        open = k;
+    }
+
+    return element->error;
+}
+
+const char* tb_json_get_error_desc(tb_json_error error)
+{
+    switch (error)
+    {
+    case TB_JSON_OK:                return "no error";
+    case TB_JSON_BAD_PATH:          return "bad path";
+    case TB_JSON_BAD_SYNTAX:        return "bad syntax";
+    case TB_JSON_BAD_TYPE:          return "bad type";
+    case TB_JSON_NOT_FOUND:         return "not found";
+    case TB_JSON_OUT_OF_RANGE:      return "value out of range";
+    case TB_JSON_ALLOC_ERROR:       return "allocation failed";
+    default:                        return "unkown error";
+    }
+}
+#endif /* !TB_JSON_IMPLEMENTATION */
+
+/*
+MIT License
+
+Copyright (c) 2020 oliverjakobs
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
\ No newline at end of file
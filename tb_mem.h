@@ -22,6 +22,75 @@ void  tb_mem_constfree(tb_allocator* allocator, const void* block);
 
 void* tb_mem_dup(tb_allocator* allocator, const void* src, size_t size);
 
+/*
+ * Arena (bump) allocator. Memory is taken from chunks that double in size (up to
+ * TB_ARENA_CHUNK_MAX), an allocation only moves the top of the current chunk. Single blocks
+ * are not freed, except for the last allocation, which can also be resized in place.
+ * Everything is released at once with tb_arena_reset (keeps the newest chunk for reuse) or
+ * tb_arena_destroy, or back to a marker saved with tb_arena_save for temporary allocations.
+ * Allocations are aligned to TB_ARENA_ALIGN, oversized ones get a chunk of their own.
+ */
+#define TB_ARENA_ALIGN          16
+#define TB_ARENA_CHUNK_DEFAULT  (1 << 16)
+#define TB_ARENA_CHUNK_MAX      (1 << 24)
+
+typedef struct tb_arena_chunk tb_arena_chunk;
+
+typedef struct
+{
+    tb_arena_chunk* chunk;  /* current chunk, linked to the previous ones */
+    size_t next_size;       /* size of the next chunk */
+    void* last;             /* last allocation, NULL if it was freed */
+    tb_allocator* backing;  /* allocator of the chunks, NULL for malloc/free */
+} tb_arena;
+
+typedef struct
+{
+    tb_arena_chunk* chunk;
+    size_t used;
+} tb_arena_marker;
+
+/* chunk_size is the size of the first chunk (0 for TB_ARENA_CHUNK_DEFAULT), backing may be NULL */
+void tb_arena_init(tb_arena* arena, size_t chunk_size, tb_allocator* backing);
+void tb_arena_destroy(tb_arena* arena);
+
+/* Frees everything allocated from the arena, the newest chunk is kept. */
+void tb_arena_reset(tb_arena* arena);
+
+/* Returns NULL if size is 0 or memory allocation failed. */
+void* tb_arena_alloc(tb_arena* arena, size_t size);
+void* tb_arena_calloc(tb_arena* arena, size_t count, size_t size);
+
+/*
+ * The last allocation is resized in place as long as it fits into its chunk, other blocks are
+ * copied into a new allocation. A block of size 0 is freed and NULL is returned.
+ */
+void* tb_arena_realloc(tb_arena* arena, void* block, size_t old_size, size_t new_size);
+
+/* Only the last allocation is given back, freeing other blocks does nothing. */
+void tb_arena_free(tb_arena* arena, void* block);
+
+/*
+ * Markers for temporary allocations: restore frees everything allocated after save.
+ * Markers have to be restored in reverse order and are invalidated by tb_arena_reset.
+ */
+tb_arena_marker tb_arena_save(const tb_arena* arena);
+void tb_arena_restore(tb_arena* arena, tb_arena_marker marker);
+
+/*
+ * tb_allocator callbacks get no context, so tb_arena_allocator allocates from the arena bound
+ * to the calling thread with tb_arena_bind (which returns the previously bound one for nesting).
+ * Blocks must be resized and freed while the same arena is bound, all of them become invalid
+ * once the arena is reset or destroyed. Without an arena bound the allocator fails.
+ * Without thread local storage (C11, GCC or MSVC) a single arena is bound for all threads.
+ */
+tb_arena* tb_arena_bind(tb_arena* arena);
+tb_allocator* tb_arena_allocator(void);
+
+/* Hooks with the signature of the tb_hashmap alloc and free callbacks, the allocator is the arena. */
+void* tb_arena_hashmap_alloc(void* arena, size_t count, size_t size);
+void  tb_arena_hashmap_free(void* arena, void* block);
+
 #endif /* !TB_MEM_H */
 
 /*
@@ -90,6 +159,227 @@ void* tb_mem_dup(tb_allocator* allocator, const void* src, size_t size)
     void* dst = tb_mem_malloc(allocator, size);
     return dst ? memcpy(dst, src, size) : NULL;
 }
+
+/* ----------------------------| Arena |------------------------------------------------------------ */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define TB_ARENA_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define TB_ARENA_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define TB_ARENA_THREAD_LOCAL __declspec(thread)
+#else
+#define TB_ARENA_THREAD_LOCAL
+#endif
+
+struct tb_arena_chunk
+{
+    tb_arena_chunk* prev;
+    size_t size;    /* bytes for allocations behind the header */
+    size_t used;
+};
+
+/* the header is padded, so the first allocation of a chunk is aligned */
+#define TB_ARENA_ALIGN_UP(n)    (((n) + TB_ARENA_ALIGN - 1) & ~(size_t)(TB_ARENA_ALIGN - 1))
+#define TB_ARENA_CHUNK_HDR      TB_ARENA_ALIGN_UP(sizeof(tb_arena_chunk))
+#define TB_ARENA_DATA(chunk)    ((char*)(chunk) + TB_ARENA_CHUNK_HDR)
+
+static tb_arena_chunk* tb_arena_chunk_create(tb_arena* arena, size_t min_size)
+{
+    size_t size = arena->next_size;
+    if (size < min_size) size = min_size;
+
+    tb_allocator* backing = arena->backing;
+    size_t chunk_size = TB_ARENA_CHUNK_HDR + size;
+
+    tb_arena_chunk* chunk = (backing && backing->malloc) ? backing->malloc(chunk_size) : malloc(chunk_size);
+    if (!chunk) return NULL;
+
+    chunk->prev = arena->chunk;
+    chunk->size = size;
+    chunk->used = 0;
+
+    arena->chunk = chunk;
+    if (arena->next_size < TB_ARENA_CHUNK_MAX) arena->next_size *= 2;
+
+    return chunk;
+}
+
+static void tb_arena_chunk_free(tb_arena* arena, tb_arena_chunk* chunk)
+{
+    tb_allocator* backing = arena->backing;
+    if (backing && backing->free)   backing->free(chunk, TB_ARENA_CHUNK_HDR + chunk->size);
+    else                            free(chunk);
+}
+
+/* frees the chunks newer than keep */
+static void tb_arena_pop_chunks(tb_arena* arena, tb_arena_chunk* keep)
+{
+    while (arena->chunk && arena->chunk != keep)
+    {
+        tb_arena_chunk* prev = arena->chunk->prev;
+        tb_arena_chunk_free(arena, arena->chunk);
+        arena->chunk = prev;
+    }
+}
+
+void tb_arena_init(tb_arena* arena, size_t chunk_size, tb_allocator* backing)
+{
+    arena->chunk = NULL;
+    arena->next_size = chunk_size ? TB_ARENA_ALIGN_UP(chunk_size) : TB_ARENA_CHUNK_DEFAULT;
+    arena->last = NULL;
+    arena->backing = backing;
+}
+
+void tb_arena_destroy(tb_arena* arena)
+{
+    tb_arena_pop_chunks(arena, NULL);
+    arena->last = NULL;
+}
+
+void tb_arena_reset(tb_arena* arena)
+{
+    tb_arena_chunk* newest = arena->chunk;
+    if (!newest) return;
+
+    /* the newest chunk is the largest, the older ones are freed */
+    tb_arena_chunk* prev = newest->prev;
+    while (prev)
+    {
+        tb_arena_chunk* next = prev->prev;
+        tb_arena_chunk_free(arena, prev);
+        prev = next;
+    }
+
+    newest->prev = NULL;
+    newest->used = 0;
+    arena->last = NULL;
+}
+
+void* tb_arena_alloc(tb_arena* arena, size_t size)
+{
+    if (size == 0) return NULL;
+
+    size_t aligned = TB_ARENA_ALIGN_UP(size);
+    if (aligned < size) return NULL; /* overflow */
+
+    tb_arena_chunk* chunk = arena->chunk;
+    if (!chunk || chunk->size - chunk->used < aligned)
+    {
+        chunk = tb_arena_chunk_create(arena, aligned);
+        if (!chunk) return NULL;
+    }
+
+    void* block = TB_ARENA_DATA(chunk) + chunk->used;
+    chunk->used += aligned;
+
+    arena->last = block;
+    return block;
+}
+
+void* tb_arena_calloc(tb_arena* arena, size_t count, size_t size)
+{
+    if (size && count > (size_t)-1 / size) return NULL; /* overflow */
+
+    void* block = tb_arena_alloc(arena, count * size);
+    return block ? memset(block, 0, count * size) : NULL;
+}
+
+void* tb_arena_realloc(tb_arena* arena, void* block, size_t old_size, size_t new_size)
+{
+    if (!block) return tb_arena_alloc(arena, new_size);
+
+    if (new_size == 0)
+    {
+        tb_arena_free(arena, block);
+        return NULL;
+    }
+
+    /* the last allocation only moves the top of its chunk */
+    tb_arena_chunk* chunk = arena->chunk;
+    if (block == arena->last && chunk)
+    {
+        size_t offset = (size_t)((char*)block - TB_ARENA_DATA(chunk));
+        size_t aligned = TB_ARENA_ALIGN_UP(new_size);
+
+        if (aligned >= new_size && aligned <= chunk->size - offset)
+        {
+            chunk->used = offset + aligned;
+            return block;
+        }
+    }
+
+    void* new_block = tb_arena_alloc(arena, new_size);
+    if (!new_block) return NULL;
+
+    memcpy(new_block, block, (old_size < new_size) ? old_size : new_size);
+    return new_block;
+}
+
+void tb_arena_free(tb_arena* arena, void* block)
+{
+    if (!block || block != arena->last || !arena->chunk) return;
+
+    arena->chunk->used = (size_t)((char*)block - TB_ARENA_DATA(arena->chunk));
+    arena->last = NULL;
+}
+
+tb_arena_marker tb_arena_save(const tb_arena* arena)
+{
+    tb_arena_marker marker;
+    marker.chunk = arena->chunk;
+    marker.used = arena->chunk ? arena->chunk->used : 0;
+    return marker;
+}
+
+void tb_arena_restore(tb_arena* arena, tb_arena_marker marker)
+{
+    tb_arena_pop_chunks(arena, marker.chunk);
+
+    if (arena->chunk) arena->chunk->used = marker.used;
+    arena->last = NULL;
+}
+
+/* ----------------------------| Arena hooks |------------------------------------------------------ */
+static TB_ARENA_THREAD_LOCAL tb_arena* tb_arena_bound = NULL;
+
+tb_arena* tb_arena_bind(tb_arena* arena)
+{
+    tb_arena* prev = tb_arena_bound;
+    tb_arena_bound = arena;
+    return prev;
+}
+
+static void* tb_arena_allocator_malloc(size_t size)
+{
+    return tb_arena_bound ? tb_arena_alloc(tb_arena_bound, size) : NULL;
+}
+
+static void* tb_arena_allocator_realloc(void* block, size_t old_size, size_t new_size)
+{
+    return tb_arena_bound ? tb_arena_realloc(tb_arena_bound, block, old_size, new_size) : NULL;
+}
+
+static void tb_arena_allocator_free(void* block, size_t size)
+{
+    (void)size;
+    if (tb_arena_bound) tb_arena_free(tb_arena_bound, block);
+}
+
+tb_allocator* tb_arena_allocator(void)
+{
+    static tb_allocator allocator = { tb_arena_allocator_malloc, tb_arena_allocator_realloc, tb_arena_allocator_free };
+    return &allocator;
+}
+
+void* tb_arena_hashmap_alloc(void* arena, size_t count, size_t size)
+{
+    return tb_arena_calloc(arena, count, size);
+}
+
+void tb_arena_hashmap_free(void* arena, void* block)
+{
+    tb_arena_free(arena, block);
+}
 #endif /* !TB_MEM_IMPLEMENTATION */
 
 /*
@@ -0,0 +1,396 @@
+#ifndef TB_QUEUE_H
+#define TB_QUEUE_H
+
+#include <stddef.h>
+
+/*
+ * Lock-free bounded queues for fixed size elements, which are copied in and out.
+ * The capacity is rounded up to a power of two. Enqueue and dequeue never block, they return
+ * the number of elements that fit or were available (possibly 0), batches move up to n elements
+ * with a single synchronization.
+ *
+ * tb_spsc: one producer and one consumer thread. Each side keeps a cached copy of the other
+ *          side's index and only reads the shared index when the cached one says the queue is
+ *          full (or empty), so the indices do not bounce between the caches of the two threads.
+ *
+ * tb_mpmc: any number of producer and consumer threads (Dmitry Vyukov's bounded queue). Every
+ *          cell has a sequence number that tells whether it is free for the enqueue or ready
+ *          for the dequeue at a position, positions are claimed with a compare and swap.
+ *
+ * Requires C11 atomics.
+ */
+
+typedef struct tb_spsc tb_spsc;
+typedef struct tb_mpmc tb_mpmc;
+
+/* Returns NULL if memory allocation failed or elem_size or capacity is 0. */
+tb_spsc* tb_spsc_create(size_t capacity, size_t elem_size);
+void     tb_spsc_destroy(tb_spsc* queue);
+
+/* Producer only: copies up to n elements from src into the queue, returns the number enqueued. */
+size_t tb_spsc_enqueue(tb_spsc* queue, const void* src, size_t n);
+
+/* Consumer only: copies up to n elements out of the queue to dst, returns the number dequeued. */
+size_t tb_spsc_dequeue(tb_spsc* queue, void* dst, size_t n);
+
+/* Number of elements in the queue, only a snapshot if the other side is running. */
+size_t tb_spsc_len(tb_spsc* queue);
+size_t tb_spsc_cap(const tb_spsc* queue);
+
+/* Returns NULL if memory allocation failed or elem_size or capacity is 0. */
+tb_mpmc* tb_mpmc_create(size_t capacity, size_t elem_size);
+void     tb_mpmc_destroy(tb_mpmc* queue);
+
+/*
+ * Copies up to n elements from src into the queue, returns the number enqueued.
+ * A batch claims consecutive positions, it stops early at the first cell that is still in use.
+ */
+size_t tb_mpmc_enqueue(tb_mpmc* queue, const void* src, size_t n);
+
+/* Copies up to n elements out of the queue to dst, returns the number dequeued. */
+size_t tb_mpmc_dequeue(tb_mpmc* queue, void* dst, size_t n);
+
+size_t tb_mpmc_cap(const tb_mpmc* queue);
+
+#endif /* !TB_QUEUE_H */
+
+/*
+ * -----------------------------------------------------------------------------
+ * ----| IMPLEMENTATION |-------------------------------------------------------
+ * -----------------------------------------------------------------------------
+ */
+#ifdef TB_QUEUE_IMPLEMENTATION
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TB_QUEUE_CACHE_LINE 64
+
+static size_t tb_queue_pow2(size_t n)
+{
+    size_t cap = 1;
+    while (cap < n) cap <<= 1;
+    return cap;
+}
+
+/* copies a single element, with constant sizes for the common cases the copy is inlined */
+static inline void tb_queue_copy_elem(void* dst, const void* src, size_t size)
+{
+    switch (size)
+    {
+    case 4:  memcpy(dst, src, 4); break;
+    case 8:  memcpy(dst, src, 8); break;
+    case 16: memcpy(dst, src, 16); break;
+    default: memcpy(dst, src, size); break;
+    }
+}
+
+/* ----------------------------| SPSC |------------------------------------------------------------- */
+/* the fields written by the producer and the consumer are kept on separate cache lines */
+struct tb_spsc
+{
+    char* buffer;
+    size_t mask;
+    size_t elem_size;
+    char pad0[TB_QUEUE_CACHE_LINE];
+
+    /* producer */
+    atomic_size_t tail;
+    size_t head_cache;
+    char pad1[TB_QUEUE_CACHE_LINE - sizeof(atomic_size_t) - sizeof(size_t)];
+
+    /* consumer */
+    atomic_size_t head;
+    size_t tail_cache;
+    char pad2[TB_QUEUE_CACHE_LINE - sizeof(atomic_size_t) - sizeof(size_t)];
+};
+
+tb_spsc* tb_spsc_create(size_t capacity, size_t elem_size)
+{
+    if (!capacity || !elem_size) return NULL;
+
+    tb_spsc* queue = malloc(sizeof(tb_spsc));
+    if (!queue) return NULL;
+
+    capacity = tb_queue_pow2(capacity);
+    queue->buffer = malloc(capacity * elem_size);
+
+    if (!queue->buffer)
+    {
+        free(queue);
+        return NULL;
+    }
+
+    queue->mask = capacity - 1;
+    queue->elem_size = elem_size;
+
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    queue->head_cache = 0;
+    queue->tail_cache = 0;
+
+    return queue;
+}
+
+void tb_spsc_destroy(tb_spsc* queue)
+{
+    if (!queue) return;
+
+    free(queue->buffer);
+    free(queue);
+}
+
+/* copies n elements between the ring at position pos and a flat buffer, in at most two parts */
+static void tb_spsc_copy(const tb_spsc* queue, size_t pos, void* flat, size_t n, int to_ring)
+{
+    size_t index = pos & queue->mask;
+    size_t first = queue->mask + 1 - index;
+    if (first > n) first = n;
+
+    char* ring = queue->buffer + (index * queue->elem_size);
+    char* data = flat;
+    size_t first_size = first * queue->elem_size;
+    size_t second_size = (n - first) * queue->elem_size;
+
+    if (to_ring)
+    {
+        memcpy(ring, data, first_size);
+        memcpy(queue->buffer, data + first_size, second_size);
+    }
+    else
+    {
+        memcpy(data, ring, first_size);
+        memcpy(data + first_size, queue->buffer, second_size);
+    }
+}
+
+size_t tb_spsc_enqueue(tb_spsc* queue, const void* src, size_t n)
+{
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    size_t cap = queue->mask + 1;
+
+    /* the shared head is only read if the cached one does not leave enough room */
+    if (cap - (tail - queue->head_cache) < n)
+        queue->head_cache = atomic_load_explicit(&queue->head, memory_order_acquire);
+
+    size_t free_slots = cap - (tail - queue->head_cache);
+    if (n > free_slots) n = free_slots;
+    if (n == 0) return 0;
+
+    tb_spsc_copy(queue, tail, (void*)src, n, 1);
+    atomic_store_explicit(&queue->tail, tail + n, memory_order_release);
+
+    return n;
+}
+
+size_t tb_spsc_dequeue(tb_spsc* queue, void* dst, size_t n)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+    if (queue->tail_cache - head < n)
+        queue->tail_cache = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+    size_t available = queue->tail_cache - head;
+    if (n > available) n = available;
+    if (n == 0) return 0;
+
+    tb_spsc_copy(queue, head, dst, n, 0);
+    atomic_store_explicit(&queue->head, head + n, memory_order_release);
+
+    return n;
+}
+
+size_t tb_spsc_len(tb_spsc* queue)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+    return tail - head;
+}
+
+size_t tb_spsc_cap(const tb_spsc* queue)
+{
+    return queue->mask + 1;
+}
+
+/* ----------------------------| MPMC |------------------------------------------------------------- */
+/*
+ * a cell is free for the enqueue at position pos if its sequence is pos and ready for the
+ * dequeue at pos if its sequence is pos + 1, the dequeue sets it to pos + capacity
+ */
+typedef struct
+{
+    atomic_size_t sequence;
+} tb_mpmc_cell;
+
+struct tb_mpmc
+{
+    char* cells;
+    size_t mask;
+    size_t elem_size;
+    size_t stride;      /* sequence and element, rounded up to keep the sequences aligned */
+    char pad0[TB_QUEUE_CACHE_LINE];
+
+    atomic_size_t enqueue_pos;
+    char pad1[TB_QUEUE_CACHE_LINE - sizeof(atomic_size_t)];
+
+    atomic_size_t dequeue_pos;
+    char pad2[TB_QUEUE_CACHE_LINE - sizeof(atomic_size_t)];
+};
+
+#define tb_mpmc_cell_at(queue, pos) ((tb_mpmc_cell*)(void*)((queue)->cells + (((pos) & (queue)->mask) * (queue)->stride)))
+#define tb_mpmc_cell_data(cell)     ((char*)(cell) + sizeof(tb_mpmc_cell))
+
+tb_mpmc* tb_mpmc_create(size_t capacity, size_t elem_size)
+{
+    if (!capacity || !elem_size) return NULL;
+
+    tb_mpmc* queue = malloc(sizeof(tb_mpmc));
+    if (!queue) return NULL;
+
+    capacity = tb_queue_pow2(capacity);
+
+    size_t align = sizeof(tb_mpmc_cell);
+    queue->stride = (sizeof(tb_mpmc_cell) + elem_size + align - 1) & ~(align - 1);
+    queue->cells = malloc(capacity * queue->stride);
+
+    if (!queue->cells)
+    {
+        free(queue);
+        return NULL;
+    }
+
+    queue->mask = capacity - 1;
+    queue->elem_size = elem_size;
+
+    for (size_t i = 0; i < capacity; ++i)
+        atomic_init(&tb_mpmc_cell_at(queue, i)->sequence, i);
+
+    atomic_init(&queue->enqueue_pos, 0);
+    atomic_init(&queue->dequeue_pos, 0);
+
+    return queue;
+}
+
+void tb_mpmc_destroy(tb_mpmc* queue)
+{
+    if (!queue) return;
+
+    free(queue->cells);
+    free(queue);
+}
+
+/*
+ * claims up to n consecutive positions starting at the current value of pos, whose cells have
+ * the sequence position + offset, returns the number of claimed positions and the first one in start
+ */
+static size_t tb_mpmc_claim(tb_mpmc* queue, atomic_size_t* pos, size_t offset, size_t n, size_t* start)
+{
+    size_t current = atomic_load_explicit(pos, memory_order_relaxed);
+
+    for (;;)
+    {
+        size_t count = 0;
+        while (count < n)
+        {
+            size_t sequence = atomic_load_explicit(&tb_mpmc_cell_at(queue, current + count)->sequence, memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)(current + count + offset);
+
+            if (diff == 0)
+            {
+                count++;
+                continue;
+            }
+
+            /* another thread already took this position, start over at the new one */
+            if (diff > 0 && count == 0) break;
+
+            /* full (or empty), or the rest of the batch is not ready yet */
+            if (count == 0) return 0;
+            break;
+        }
+
+        if (count == 0)
+        {
+            current = atomic_load_explicit(pos, memory_order_relaxed);
+            continue;
+        }
+
+        /* the cells stay ready, only the thread that claims their positions changes them */
+        if (atomic_compare_exchange_weak_explicit(pos, &current, current + count, memory_order_relaxed, memory_order_relaxed))
+        {
+            *start = current;
+            return count;
+        }
+    }
+}
+
+size_t tb_mpmc_enqueue(tb_mpmc* queue, const void* src, size_t n)
+{
+    if (n == 0) return 0;
+
+    size_t start;
+    size_t count = tb_mpmc_claim(queue, &queue->enqueue_pos, 0, n, &start);
+
+    const char* data = src;
+    for (size_t i = 0; i < count; ++i)
+    {
+        tb_mpmc_cell* cell = tb_mpmc_cell_at(queue, start + i);
+
+        tb_queue_copy_elem(tb_mpmc_cell_data(cell), data + (i * queue->elem_size), queue->elem_size);
+        atomic_store_explicit(&cell->sequence, start + i + 1, memory_order_release);
+    }
+
+    return count;
+}
+
+size_t tb_mpmc_dequeue(tb_mpmc* queue, void* dst, size_t n)
+{
+    if (n == 0) return 0;
+
+    size_t start;
+    size_t count = tb_mpmc_claim(queue, &queue->dequeue_pos, 1, n, &start);
+
+    char* data = dst;
+    for (size_t i = 0; i < count; ++i)
+    {
+        tb_mpmc_cell* cell = tb_mpmc_cell_at(queue, start + i);
+
+        tb_queue_copy_elem(data + (i * queue->elem_size), tb_mpmc_cell_data(cell), queue->elem_size);
+        atomic_store_explicit(&cell->sequence, start + i + queue->mask + 1, memory_order_release);
+    }
+
+    return count;
+}
+
+size_t tb_mpmc_cap(const tb_mpmc* queue)
+{
+    return queue->mask + 1;
+}
+#endif /* !TB_QUEUE_IMPLEMENTATION */
+
+/*
+MIT License
+
+Copyright (c) 2020 oliverjakobs
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
\ No newline at end of file
@@ -0,0 +1,249 @@
+#ifndef TB_RING_H
+#define TB_RING_H
+
+#include "tb_array.h"
+
+/*
+ * Growable ring buffer (deque) in the style of tb_array. A ring is a pointer to its elements
+ * (NULL is an empty ring) with the head index in front of the regular tb_array header, so
+ * tb_array_len and tb_array_cap also work on rings. The capacity is always a power of two
+ * and element i of the ring is found at (head + i) & (cap - 1).
+ *
+ * Push and pop are O(1) at both ends, growth doubles the capacity and moves only the smaller
+ * of the two wrapped parts. The elements are at most two contiguous spans: the first span
+ * starts at the head, the second one (if the ring wraps) at the start of the buffer.
+ *
+ * A ring must be freed with tb_ring_free, not tb_array_free.
+ */
+#define TB_RING_HDR_SIZE    4 * sizeof(TB_ARRAY_HDR_ELEM)
+
+#define tb_ring__head(r)    ((size_t*)(void*)(r) - 4)[0]
+#define tb_ring__mask(r)    (tb_array__cap(r) - 1)
+#define tb_ring__index(r, i) ((tb_ring__head(r) + (i)) & tb_ring__mask(r))
+
+#define tb_ring_len(r)      tb_array_len(r)
+#define tb_ring_cap(r)      tb_array_cap(r)
+#define tb_ring_empty(r)    (tb_ring_len(r) == 0)
+
+#define tb_ring_grow(r, n)      (*((void**)&(r)) = tb_ring__grow((r), (n), sizeof(*(r))))
+#define tb_ring_reserve(r, n)   (*((void**)&(r)) = tb_ring__reserve((r), (n), sizeof(*(r))))
+#define tb_ring_free(r)         (tb_ring__free(r), (r) = NULL)
+#define tb_ring_clear(r)        ((r) ? tb_array__len(r) = 0, tb_ring__head(r) = 0 : 0)
+
+/* element i counted from the front (i < len) */
+#define tb_ring_at(r, i)    (r)[tb_ring__index((r), (i))]
+#define tb_ring_front(r)    (r)[tb_ring__head(r)]
+#define tb_ring_back(r)     (r)[tb_ring__index((r), tb_array__len(r) - 1)]
+
+#define tb_ring_push_back(r, v)     (tb_ring_grow((r), 1), (r)[tb_ring__index((r), tb_array__len(r)++)] = (v))
+#define tb_ring_push_front(r, v)    (tb_ring_grow((r), 1), (r)[tb_ring__push_front(r)] = (v))
+
+/* remove and return the element at the front or back, the ring must not be empty */
+#define tb_ring_pop_front(r)    (r)[tb_ring__pop_front(r)]
+#define tb_ring_pop_back(r)     (r)[tb_ring__pop_back(r)]
+
+/*
+ * the two contiguous spans of the ring, in order
+ * the second span is empty unless the ring wraps around the end of the buffer
+ */
+#define tb_ring_first_span(r)   ((r) ? (r) + tb_ring__head(r) : NULL)
+#define tb_ring_first_len(r)    ((r) ? tb_ring__first_len(r) : 0)
+#define tb_ring_second_span(r)  (r)
+#define tb_ring_second_len(r)   (tb_ring_len(r) - tb_ring_first_len(r))
+
+/*
+ * bulk operations, each does at most one reallocation and two memcpys
+ * tb_ring_push_back_n: appends n elements copied from src
+ * tb_ring_pop_front_n: removes up to n elements from the front and copies them to dst (dst may be NULL),
+ *                      returns the number of removed elements
+ */
+#define tb_ring_push_back_n(r, src, n)  (*((void**)&(r)) = tb_ring__write((r), (src), (n), sizeof(*(r))))
+#define tb_ring_pop_front_n(r, dst, n)  (tb_ring__read((r), (dst), (n), sizeof(*(r))))
+
+void* tb_ring__grow(void* ring, size_t increment, size_t elem_size);
+void* tb_ring__reserve(void* ring, size_t reserve, size_t elem_size);
+void  tb_ring__free(void* ring);
+
+size_t tb_ring__first_len(const void* ring);
+size_t tb_ring__push_front(void* ring);
+size_t tb_ring__pop_front(void* ring);
+size_t tb_ring__pop_back(void* ring);
+
+void*  tb_ring__write(void* ring, const void* src, size_t n, size_t elem_size);
+size_t tb_ring__read(void* ring, void* dst, size_t n, size_t elem_size);
+
+#endif /* !TB_RING_H */
+
+/*
+ * -----------------------------------------------------------------------------
+ * ----| IMPLEMENTATION |-------------------------------------------------------
+ * -----------------------------------------------------------------------------
+ */
+#ifdef TB_RING_IMPLEMENTATION
+
+#include <string.h>
+
+#define tb_ring__hdr(r) ((size_t*)(void*)(r) - 4)
+
+static void* tb_ring_resize(void* ring, size_t new_cap, size_t elem_size)
+{
+    size_t* hdr = ring ? tb_ring__hdr(ring) : NULL;
+    size_t old_cap = tb_ring_cap(ring);
+
+    hdr = realloc(hdr, TB_RING_HDR_SIZE + (new_cap * elem_size));
+
+    if (!hdr) return NULL; /* out of memory */
+
+    char* data = (char*)(hdr + 4);
+    if (!ring)
+    {
+        hdr[0] = 0;
+        hdr[1] = 0;
+        hdr[3] = 0;
+    }
+
+    /*
+     * a wrapped ring continues behind the old capacity, either the part at the start of the buffer
+     * is moved behind the old end or the part at the end is moved to the new end, whichever is smaller
+     */
+    size_t head = hdr[0];
+    size_t len = hdr[3];
+    if (head + len > old_cap)
+    {
+        size_t tail = head + len - old_cap;
+        size_t front = old_cap - head;
+
+        if (tail <= front)
+        {
+            memcpy(data + (old_cap * elem_size), data, tail * elem_size);
+        }
+        else
+        {
+            memcpy(data + ((new_cap - front) * elem_size), data + (head * elem_size), front * elem_size);
+            hdr[0] = new_cap - front;
+        }
+    }
+
+    hdr[2] = new_cap;
+    return data;
+}
+
+static size_t tb_ring_pow2(size_t n)
+{
+    size_t cap = 1;
+    while (cap < n) cap <<= 1;
+    return cap;
+}
+
+void* tb_ring__grow(void* ring, size_t increment, size_t elem_size)
+{
+    if (ring && tb_array__len(ring) + increment <= tb_array__cap(ring)) return ring;
+
+    size_t new_size = tb_ring_len(ring) + increment;
+    size_t new_cap = ring ? 2 * tb_array__cap(ring) : 1;
+
+    return tb_ring_resize(ring, tb_ring_pow2((new_cap < new_size) ? new_size : new_cap), elem_size);
+}
+
+void* tb_ring__reserve(void* ring, size_t reserve, size_t elem_size)
+{
+    if (ring && reserve <= tb_array__cap(ring)) return ring;
+    return tb_ring_resize(ring, tb_ring_pow2(reserve), elem_size);
+}
+
+void tb_ring__free(void* ring)
+{
+    if (ring) free(tb_ring__hdr(ring));
+}
+
+size_t tb_ring__first_len(const void* ring)
+{
+    size_t to_end = tb_array__cap(ring) - tb_ring__head(ring);
+    return (tb_array__len(ring) < to_end) ? tb_array__len(ring) : to_end;
+}
+
+size_t tb_ring__push_front(void* ring)
+{
+    tb_ring__head(ring) = (tb_ring__head(ring) - 1) & tb_ring__mask(ring);
+    tb_array__len(ring)++;
+    return tb_ring__head(ring);
+}
+
+size_t tb_ring__pop_front(void* ring)
+{
+    size_t head = tb_ring__head(ring);
+    tb_ring__head(ring) = (head + 1) & tb_ring__mask(ring);
+    tb_array__len(ring)--;
+    return head;
+}
+
+size_t tb_ring__pop_back(void* ring)
+{
+    return tb_ring__index(ring, --tb_array__len(ring));
+}
+
+void* tb_ring__write(void* ring, const void* src, size_t n, size_t elem_size)
+{
+    if (n == 0) return ring;
+
+    ring = tb_ring__grow(ring, n, elem_size);
+    if (!ring) return NULL; /* out of memory */
+
+    size_t cap = tb_array__cap(ring);
+    size_t tail = tb_ring__index(ring, tb_array__len(ring));
+    size_t first = (n < cap - tail) ? n : cap - tail;
+
+    char* data = ring;
+    memcpy(data + (tail * elem_size), src, first * elem_size);
+    memcpy(data, (const char*)src + (first * elem_size), (n - first) * elem_size);
+
+    tb_array__len(ring) += n;
+    return ring;
+}
+
+size_t tb_ring__read(void* ring, void* dst, size_t n, size_t elem_size)
+{
+    size_t len = tb_ring_len(ring);
+    if (n > len) n = len;
+    if (n == 0) return 0;
+
+    size_t head = tb_ring__head(ring);
+    size_t first = tb_ring__first_len(ring);
+    if (first > n) first = n;
+
+    if (dst)
+    {
+        const char* data = ring;
+        memcpy(dst, data + (head * elem_size), first * elem_size);
+        memcpy((char*)dst + (first * elem_size), data, (n - first) * elem_size);
+    }
+
+    tb_ring__head(ring) = (head + n) & tb_ring__mask(ring);
+    tb_array__len(ring) -= n;
+    return n;
+}
+#endif /* !TB_RING_IMPLEMENTATION */
+
+/*
+MIT License
+
+Copyright (c) 2020 oliverjakobs
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
\ No newline at end of file
@@ -0,0 +1,277 @@
+#ifndef TB_SEGARRAY_H
+#define TB_SEGARRAY_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "tb_mem.h"
+
+/*
+ * Segmented array: the elements are stored in fixed size chunks of a power of two elements
+ * that are found through a chunk table. Growing the array only adds chunks, the elements are
+ * never moved, so pointers to them stay valid until they are removed. Random access is one
+ * shift, one mask and two loads.
+ *
+ * Chunks that are no longer used after pop, resize or clear stay in the chunk table and are
+ * recycled once the array grows again, tb_segarray_shrink gives them back to the allocator.
+ */
+
+#define TB_SEGARRAY_CHUNK_DEFAULT   4096 /* bytes per chunk if no element count is given */
+
+typedef enum
+{
+    TB_SEGARRAY_OK = 0,
+    TB_SEGARRAY_ERROR,
+    TB_SEGARRAY_ALLOC_ERROR,
+    TB_SEGARRAY_OUT_OF_RANGE
+} tb_segarray_error;
+
+typedef struct
+{
+    char** chunks;          /* chunk table */
+    size_t chunk_count;     /* allocated chunks, the first chunk_count entries of the table */
+    size_t table_cap;
+
+    size_t len;
+    size_t elem_size;
+
+    size_t shift;           /* log2 of the elements per chunk */
+    size_t mask;            /* elements per chunk - 1 */
+
+    tb_allocator* allocator;
+} tb_segarray;
+
+/*
+ * Initialize an empty segmented array for elements of elem_size bytes.
+ * chunk_elems is rounded up to a power of two, 0 picks a chunk of about TB_SEGARRAY_CHUNK_DEFAULT bytes.
+ * allocator may be NULL for malloc/realloc/free.
+ */
+tb_segarray_error tb_segarray_init(tb_segarray* arr, size_t elem_size, size_t chunk_elems, tb_allocator* allocator);
+
+/* Free all chunks and the chunk table. */
+void tb_segarray_destroy(tb_segarray* arr);
+
+/* Unchecked access to the element at index i (i < len). */
+#define tb_segarray_at(arr, i) ((void*)((arr)->chunks[(i) >> (arr)->shift] + (((i) & (arr)->mask) * (arr)->elem_size)))
+
+#define tb_segarray_len(arr)        ((arr)->len)
+#define tb_segarray_cap(arr)        ((arr)->chunk_count << (arr)->shift)
+#define tb_segarray_chunk_len(arr)  ((arr)->mask + 1)
+
+/* Return the element at index, or NULL if index is out of range. */
+void* tb_segarray_get(const tb_segarray* arr, size_t index);
+
+/*
+ * Append a copy of the element at src (uninitialized if src is NULL).
+ * Returns a pointer to the new element, which stays valid until it is removed, or NULL if memory allocation failed.
+ */
+void* tb_segarray_push(tb_segarray* arr, const void* src);
+
+/* Remove the last element, returns TB_SEGARRAY_OUT_OF_RANGE if the array is empty. */
+tb_segarray_error tb_segarray_pop(tb_segarray* arr);
+
+/* Make room for at least cap elements without changing the length. */
+tb_segarray_error tb_segarray_reserve(tb_segarray* arr, size_t cap);
+
+/* Change the length to len, new elements are uninitialized. */
+tb_segarray_error tb_segarray_resize(tb_segarray* arr, size_t len);
+
+/* Remove all elements, the chunks are kept for reuse. */
+void tb_segarray_clear(tb_segarray* arr);
+
+/* Free the chunks that are not used by any element. */
+void tb_segarray_shrink(tb_segarray* arr);
+
+const char* tb_segarray_get_error_desc(tb_segarray_error error);
+
+#endif /* !TB_SEGARRAY_H */
+
+/*
+ * -----------------------------------------------------------------------------
+ * ----| IMPLEMENTATION |-------------------------------------------------------
+ * -----------------------------------------------------------------------------
+ */
+#ifdef TB_SEGARRAY_IMPLEMENTATION
+
+#include <string.h>
+
+#define TB_SEGARRAY_TABLE_MIN   8
+
+static void* tb_segarray_alloc(tb_segarray* arr, size_t size)
+{
+    tb_allocator* allocator = arr->allocator;
+    return (allocator && allocator->malloc) ? allocator->malloc(size) : malloc(size);
+}
+
+static void tb_segarray_free(tb_segarray* arr, void* block, size_t size)
+{
+    tb_allocator* allocator = arr->allocator;
+    if (allocator && allocator->free)   allocator->free(block, size);
+    else                                free(block);
+}
+
+static size_t tb_segarray_chunk_size(const tb_segarray* arr)
+{
+    return (arr->mask + 1) * arr->elem_size;
+}
+
+/* the table only holds pointers, growing it copies chunk_count pointers but no elements */
+static int tb_segarray_grow_table(tb_segarray* arr, size_t min_cap)
+{
+    if (min_cap <= arr->table_cap) return 1;
+
+    size_t new_cap = arr->table_cap ? arr->table_cap : TB_SEGARRAY_TABLE_MIN;
+    while (new_cap < min_cap) new_cap <<= 1;
+
+    size_t old_size = arr->table_cap * sizeof(char*);
+    size_t new_size = new_cap * sizeof(char*);
+
+    tb_allocator* allocator = arr->allocator;
+    char** table = (allocator && allocator->realloc) ? allocator->realloc(arr->chunks, old_size, new_size) : realloc(arr->chunks, new_size);
+
+    if (!table) return 0;
+
+    arr->chunks = table;
+    arr->table_cap = new_cap;
+    return 1;
+}
+
+tb_segarray_error tb_segarray_init(tb_segarray* arr, size_t elem_size, size_t chunk_elems, tb_allocator* allocator)
+{
+    if (!arr || !elem_size) return TB_SEGARRAY_ERROR;
+
+    if (!chunk_elems) chunk_elems = TB_SEGARRAY_CHUNK_DEFAULT / elem_size;
+
+    size_t shift = 0;
+    while (((size_t)1 << shift) < chunk_elems) shift++;
+
+    arr->chunks = NULL;
+    arr->chunk_count = 0;
+    arr->table_cap = 0;
+    arr->len = 0;
+    arr->elem_size = elem_size;
+    arr->shift = shift;
+    arr->mask = ((size_t)1 << shift) - 1;
+    arr->allocator = allocator;
+
+    return TB_SEGARRAY_OK;
+}
+
+void tb_segarray_destroy(tb_segarray* arr)
+{
+    if (!arr) return;
+
+    tb_segarray_clear(arr);
+    tb_segarray_shrink(arr);
+}
+
+void* tb_segarray_get(const tb_segarray* arr, size_t index)
+{
+    if (!arr || index >= arr->len) return NULL;
+    return tb_segarray_at(arr, index);
+}
+
+void* tb_segarray_push(tb_segarray* arr, const void* src)
+{
+    size_t chunk = arr->len >> arr->shift;
+    if (chunk >= arr->chunk_count && tb_segarray_reserve(arr, arr->len + 1) != TB_SEGARRAY_OK) return NULL;
+
+    char* elem = arr->chunks[chunk] + ((arr->len++ & arr->mask) * arr->elem_size);
+    if (src) memcpy(elem, src, arr->elem_size);
+
+    return elem;
+}
+
+tb_segarray_error tb_segarray_pop(tb_segarray* arr)
+{
+    if (!arr->len) return TB_SEGARRAY_OUT_OF_RANGE;
+
+    arr->len--;
+    return TB_SEGARRAY_OK;
+}
+
+tb_segarray_error tb_segarray_reserve(tb_segarray* arr, size_t cap)
+{
+    size_t count = (cap + arr->mask) >> arr->shift;
+    if (count <= arr->chunk_count) return TB_SEGARRAY_OK;
+
+    if (!tb_segarray_grow_table(arr, count)) return TB_SEGARRAY_ALLOC_ERROR;
+
+    size_t chunk_size = tb_segarray_chunk_size(arr);
+    while (arr->chunk_count < count)
+    {
+        char* chunk = tb_segarray_alloc(arr, chunk_size);
+        if (!chunk) return TB_SEGARRAY_ALLOC_ERROR;
+
+        arr->chunks[arr->chunk_count++] = chunk;
+    }
+
+    return TB_SEGARRAY_OK;
+}
+
+tb_segarray_error tb_segarray_resize(tb_segarray* arr, size_t len)
+{
+    tb_segarray_error error = tb_segarray_reserve(arr, len);
+    if (error != TB_SEGARRAY_OK) return error;
+
+    arr->len = len;
+    return TB_SEGARRAY_OK;
+}
+
+void tb_segarray_clear(tb_segarray* arr)
+{
+    arr->len = 0;
+}
+
+void tb_segarray_shrink(tb_segarray* arr)
+{
+    size_t used = (arr->len + arr->mask) >> arr->shift;
+    size_t chunk_size = tb_segarray_chunk_size(arr);
+
+    while (arr->chunk_count > used)
+        tb_segarray_free(arr, arr->chunks[--arr->chunk_count], chunk_size);
+
+    if (used == 0 && arr->chunks)
+    {
+        tb_segarray_free(arr, arr->chunks, arr->table_cap * sizeof(char*));
+        arr->chunks = NULL;
+        arr->table_cap = 0;
+    }
+}
+
+const char* tb_segarray_get_error_desc(tb_segarray_error error)
+{
+    switch (error)
+    {
+    case TB_SEGARRAY_OK:            return "no error";
+    case TB_SEGARRAY_ERROR:         return "error";
+    case TB_SEGARRAY_ALLOC_ERROR:   return "allocation failed";
+    case TB_SEGARRAY_OUT_OF_RANGE:  return "index out of range";
+    default:                        return "unkown error";
+    }
+}
+#endif /* !TB_SEGARRAY_IMPLEMENTATION */
+
+/*
+MIT License
+
+Copyright (c) 2020 oliverjakobs
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
\ No newline at end of file